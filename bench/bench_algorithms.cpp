@@ -0,0 +1,109 @@
+#include <benchmark/benchmark.h>
+
+#include <memory>
+
+#include "algorithm_utils.h"
+#include "board_satellite_view.h"
+#include "global_config.h"
+#include "smart_algorithm.h"
+#include "smart_player.h"
+
+#include "bench_utils.h"
+
+
+namespace
+{
+
+// Exposes the shell direction inference of the player, which is otherwise only reached through a battle info
+class ShellInferencePlayer : public SmartPlayer
+{
+public:
+    using SmartPlayer::SmartPlayer;
+
+    void infer(const SatelliteSnapshot& prev_snapshot, const Grid& curr_grid)
+    {
+        shell_possible_directions_.clear(); // Nothing known from before, so every run does the same work
+        updateShellPossibleDirections(prev_snapshot, curr_grid);
+    }
+};
+
+// Turning a satellite image into the grid a tank plans on
+void BM_ReconstructGrid(benchmark::State& state)
+{
+    BenchBoard bench(static_cast<size_t>(state.range(0)), 8);
+    if (!bench.is_valid())
+    {
+        state.SkipWithError("Failed to load the board");
+        return;
+    }
+    bench.fireVolleys(8);
+
+    const SatelliteSnapshot snapshot = snapshotOf(bench.board().getGrid());
+    Grid grid;
+    Position tank_pos;
+    for (auto _ : state)
+    {
+        reconstructGridFromSnapshot(grid, snapshot, 1, 10, tank_pos);
+        benchmark::DoNotOptimize(tank_pos);
+    }
+
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(grid.size()));
+}
+
+// Inferring the directions of the shells in the air from two consecutive images, as far apart as battle infos get
+void BM_ShellInference(benchmark::State& state)
+{
+    const size_t size = static_cast<size_t>(state.range(0));
+    BenchBoard bench(size, 8, kOpenBoardSpacing);
+    if (!bench.is_valid())
+    {
+        state.SkipWithError("Failed to load the board");
+        return;
+    }
+
+    Grid curr_grid;
+    Position tank_pos;
+    bench.fireVolleys(4);
+    const SatelliteSnapshot prev_snapshot = snapshotOf(bench.board().getGrid());
+    bench.fireVolleys(1 + config::get<size_t>("battle_info_interval")); // A volley in between
+    reconstructGridFromSnapshot(curr_grid, snapshotOf(bench.board().getGrid()), 1, 10, tank_pos);
+
+    ShellInferencePlayer player(1, size, size, 1000, 10);
+    for (auto _ : state)
+    {
+        player.infer(prev_snapshot, curr_grid);
+    }
+
+    state.counters["shells"] = static_cast<double>(getNumberOfShellsInGrid(curr_grid));
+}
+
+// A tank's turn right after a battle info, with a search for a safe path to the opponent.
+// Every iteration is a new tank, so no previous search can be reused.
+void BM_SmartAlgorithmSearch(benchmark::State& state)
+{
+    const size_t size = static_cast<size_t>(state.range(0));
+    BenchBoard bench(size, 1);
+    if (!bench.is_valid())
+    {
+        state.SkipWithError("Failed to load the board");
+        return;
+    }
+
+    const SatelliteSnapshot snapshot = snapshotOf(bench.board().getGrid());
+    const Position tank_pos = bench.tanks().front()->position();
+    SmartPlayer player(1, size, size, 1000, 10);
+    for (auto _ : state)
+    {
+        SmartAlgorithm algorithm(1, 0);
+        BoardSatelliteView view(snapshot, tank_pos);
+        algorithm.getAction(); // Asks for a battle info first
+        player.updateTankWithBattleInfo(algorithm, view);
+        benchmark::DoNotOptimize(algorithm.getAction());
+    }
+}
+
+} // namespace
+
+BENCHMARK(BM_ReconstructGrid)->Arg(50)->Arg(200)->Arg(1000);
+BENCHMARK(BM_ShellInference)->Arg(50)->Arg(200);
+BENCHMARK(BM_SmartAlgorithmSearch)->Arg(20)->Arg(50)->Arg(100)->Unit(benchmark::kMillisecond);
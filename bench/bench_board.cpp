@@ -0,0 +1,124 @@
+#include <benchmark/benchmark.h>
+
+#include "board.h"
+
+#include "bench_utils.h"
+
+
+namespace
+{
+
+// Rotating a tank back and forth, the cost of dispatching an action that leaves the board as it was
+void BM_ExecuteTankAction(benchmark::State& state)
+{
+    BenchBoard bench(50, 4);
+    if (!bench.is_valid())
+    {
+        state.SkipWithError("Failed to load the board");
+        return;
+    }
+
+    const auto& tank = bench.tanks().front();
+    for (auto _ : state)
+    {
+        ActionRequest left = ActionRequest::RotateLeft90;
+        ActionRequest right = ActionRequest::RotateRight90;
+        benchmark::DoNotOptimize(bench.board().executeTankAction(tank, left));
+        benchmark::DoNotOptimize(bench.board().executeTankAction(tank, right));
+    }
+
+    state.SetItemsProcessed(2 * state.iterations());
+}
+
+// Shells steps, collision resolution included, with the shells of a few volleys in the air.
+// The board is rolled back to the volleys every few steps, before the shells are all gone, so the steps are journaled.
+void BM_DoShellsStep(benchmark::State& state)
+{
+    BenchBoard bench(static_cast<size_t>(state.range(0)), 8, kOpenBoardSpacing);
+    if (!bench.is_valid())
+    {
+        state.SkipWithError("Failed to load the board");
+        return;
+    }
+
+    bench.fireVolleys(5);
+
+    constexpr size_t kStepsPerRollback = 8;
+    Board::Checkpoint checkpoint = bench.board().checkpoint();
+    size_t steps = 0;
+    for (auto _ : state)
+    {
+        bench.board().doShellsStep(steps % 2 == 1);
+        if (++steps % kStepsPerRollback == 0)
+        {
+            state.PauseTiming();
+            bench.board().rollback(checkpoint);
+            checkpoint = bench.board().checkpoint();
+            state.ResumeTiming();
+        }
+    }
+    bench.board().rollback(checkpoint);
+
+    size_t shells = 0;
+    for (const auto& cell : bench.board().getGrid())
+    {
+        shells += cell.getObjectsByType(ObjectType::Shell).size();
+    }
+    state.counters["shells"] = static_cast<double>(shells);
+}
+
+// Full rounds, actions, shells steps and collisions, rolled back to the start every few rounds
+void BM_BoardRound(benchmark::State& state)
+{
+    BenchBoard bench(static_cast<size_t>(state.range(0)), 8);
+    if (!bench.is_valid())
+    {
+        state.SkipWithError("Failed to load the board");
+        return;
+    }
+
+    constexpr size_t kRoundsPerRollback = 16;
+    Board::Checkpoint checkpoint = bench.board().checkpoint();
+    size_t round = 0;
+    for (auto _ : state)
+    {
+        bench.playRound(round);
+        if (++round % kRoundsPerRollback == 0)
+        {
+            state.PauseTiming();
+            bench.board().rollback(checkpoint);
+            checkpoint = bench.board().checkpoint();
+            state.ResumeTiming();
+        }
+    }
+    bench.board().rollback(checkpoint);
+}
+
+// Simulating a few rounds ahead and rolling back, the cost of one lookahead
+void BM_LookaheadRollback(benchmark::State& state)
+{
+    BenchBoard bench(100, 8);
+    if (!bench.is_valid())
+    {
+        state.SkipWithError("Failed to load the board");
+        return;
+    }
+
+    const size_t rounds_ahead = static_cast<size_t>(state.range(0));
+    for (auto _ : state)
+    {
+        Board::Checkpoint checkpoint = bench.board().checkpoint();
+        for (size_t round = 0; round < rounds_ahead; ++round)
+        {
+            bench.playRound(round);
+        }
+        bench.board().rollback(checkpoint);
+    }
+}
+
+} // namespace
+
+BENCHMARK(BM_ExecuteTankAction);
+BENCHMARK(BM_DoShellsStep)->Arg(50)->Arg(200);
+BENCHMARK(BM_BoardRound)->Arg(50)->Arg(200);
+BENCHMARK(BM_LookaheadRollback)->Arg(1)->Arg(4)->Arg(16);
@@ -0,0 +1,63 @@
+#include <benchmark/benchmark.h>
+
+#include <string>
+
+#include "concrete_player_factory.h"
+#include "concrete_tank_algorithm_factory.h"
+#include "board_generator.h"
+#include "game_manager.h"
+
+#include "bench_utils.h"
+
+
+namespace
+{
+
+// Plays full headless games on a board, and reports games per second
+void playGames(benchmark::State& state, const std::string& board_file, const GameOptions& options = GameOptions{.headless = true})
+{
+    ConcretePlayerFactory player_factory;
+    ConcreteTankAlgorithmFactory algorithm_factory;
+
+    for (auto _ : state)
+    {
+        GameManager game{player_factory, algorithm_factory, options};
+        if (!game.readBoard(board_file))
+        {
+            state.SkipWithError("Failed to read the board");
+            break;
+        }
+        game.run();
+    }
+
+    state.counters["games_per_second"] = benchmark::Counter(static_cast<double>(state.iterations()), benchmark::Counter::kIsRate);
+}
+
+// One of the demonstration boards
+void BM_HeadlessGame(benchmark::State& state, const std::string& board_name)
+{
+    playGames(state, prepareBoard(board_name));
+}
+
+// A generated square board of the given size, two tanks a player, capped at 200 steps so the large ones finish
+void BM_GeneratedGame(benchmark::State& state)
+{
+    playGames(state, generateBoard(static_cast<size_t>(state.range(0)), 2, 200));
+}
+
+// Nine players with four tanks each, their algorithms choosing one by one or on the given number of threads
+void BM_ManyTanksGame(benchmark::State& state)
+{
+    auto board_file = (benchDirectory() / "many_tanks.txt").string();
+    BoardGenerator(BoardGeneratorOptions{.width = 60, .height = 60, .players = 9, .tanks_per_player = 4, .max_steps = 100, .seed = 9})
+        .writeToFile(board_file);
+    playGames(state, board_file, GameOptions{.headless = true, .action_threads = static_cast<size_t>(state.range(0))});
+}
+
+} // namespace
+
+BENCHMARK_CAPTURE(BM_HeadlessGame, input_a, std::string("input_a.txt"))->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(BM_HeadlessGame, input_b, std::string("input_b.txt"))->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(BM_HeadlessGame, input_c, std::string("input_c.txt"))->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_GeneratedGame)->Arg(10)->Arg(50)->Arg(100)->Arg(500)->Arg(1000)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_ManyTanksGame)->Arg(1)->Arg(2)->Arg(4)->Arg(8)->UseRealTime()->Unit(benchmark::kMillisecond);
@@ -0,0 +1,39 @@
+#include <benchmark/benchmark.h>
+
+#include <string>
+
+#include "board.h"
+#include "concrete_player_factory.h"
+#include "concrete_tank_algorithm_factory.h"
+
+#include "bench_utils.h"
+
+
+namespace
+{
+
+// Loads a large board from scratch, and reports the cells loaded per second
+void BM_LoadBoard(benchmark::State& state)
+{
+    const size_t size = static_cast<size_t>(state.range(0));
+    const std::string board_file = generateBoard(size);
+    ConcretePlayerFactory player_factory;
+    ConcreteTankAlgorithmFactory algorithm_factory;
+
+    for (auto _ : state)
+    {
+        Board board(player_factory, algorithm_factory);
+        if (!board.loadFromFile(board_file).is_valid)
+        {
+            state.SkipWithError("Failed to load the board");
+            break;
+        }
+        benchmark::DoNotOptimize(board.getGrid().size());
+    }
+
+    state.counters["cells_per_second"] = benchmark::Counter(static_cast<double>(state.iterations() * size * size), benchmark::Counter::kIsRate);
+}
+
+} // namespace
+
+BENCHMARK(BM_LoadBoard)->Arg(500)->Arg(2000)->Unit(benchmark::kMillisecond);
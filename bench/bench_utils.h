@@ -0,0 +1,129 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "board.h"
+#include "board_generator.h"
+#include "board_satellite_view.h"
+#include "concrete_player_factory.h"
+#include "concrete_tank_algorithm_factory.h"
+#include "grid.h"
+#include "satellite_snapshot.h"
+
+
+// Boards for the benchmarks, written to a temporary directory so the output files of the
+// benchmarked games don't pollute the source tree
+
+inline std::filesystem::path benchDirectory()
+{
+    auto bench_dir = std::filesystem::temp_directory_path() / "tanks_game_bench";
+    std::filesystem::create_directories(bench_dir);
+    return bench_dir;
+}
+
+// Copies one of the demonstration boards from resources/
+inline std::string prepareBoard(const std::string& board_name)
+{
+    auto target = benchDirectory() / board_name;
+    std::filesystem::copy_file(std::filesystem::path(TANKS_GAME_SOURCE_DIR) / "resources" / board_name, target,
+                               std::filesystem::copy_options::overwrite_existing);
+    return target.string();
+}
+
+// Writes a size x size board with a wall and a mine per obstacle_spacing cells and the tanks of two players,
+// all scattered at random. The same arguments always give the same board.
+inline std::string generateBoard(size_t size, size_t tanks_per_player = 1, size_t max_steps = 1000, size_t obstacle_spacing = 13)
+{
+    auto target = benchDirectory() / ("generated_" + std::to_string(size) + "_" + std::to_string(tanks_per_player) + "_" +
+                                      std::to_string(max_steps) + "_" + std::to_string(obstacle_spacing) + ".txt");
+
+    BoardGeneratorOptions options;
+    options.width = size;
+    options.height = size;
+    options.wall_density = 1.0 / static_cast<double>(obstacle_spacing);
+    options.mine_density = 1.0 / static_cast<double>(obstacle_spacing);
+    options.tanks_per_player = tanks_per_player;
+    options.max_steps = max_steps;
+    options.seed = size;
+    BoardGenerator(options).writeToFile(target.string());
+
+    return target.string();
+}
+
+// Few enough obstacles for shells to stay in the air for a while
+inline constexpr size_t kOpenBoardSpacing = 101;
+
+// The satellite image of a grid, as the board sends it to the players
+inline SatelliteSnapshot snapshotOf(const Grid& grid)
+{
+    SatelliteSnapshot snapshot(grid.width(), grid.height());
+    for (const auto& cell : grid)
+    {
+        snapshot[grid.position(grid.index(cell))] = BoardSatelliteView::cellToChar(cell);
+    }
+    return snapshot;
+}
+
+// Shooting, moving and rotating, so shells fly, walls break and tanks meet
+inline constexpr std::array<ActionRequest, 6> kScript = {ActionRequest::Shoot, ActionRequest::MoveForward, ActionRequest::RotateLeft45,
+                                                         ActionRequest::MoveForward, ActionRequest::Shoot, ActionRequest::RotateRight90};
+
+// A loaded generated board and its tanks
+class BenchBoard
+{
+public:
+    BenchBoard(size_t size, size_t tanks_per_player, size_t obstacle_spacing = 13) : board_(player_factory_, algorithm_factory_)
+    {
+        GameInfo info = board_.loadFromFile(generateBoard(size, tanks_per_player, 1000, obstacle_spacing));
+        valid_ = info.is_valid;
+        tanks_ = std::move(info.ordered_tanks);
+    }
+
+    BenchBoard(const BenchBoard&) = delete;
+    BenchBoard& operator=(const BenchBoard&) = delete;
+    BenchBoard(BenchBoard&&) = delete;
+    BenchBoard& operator=(BenchBoard&&) = delete;
+
+    bool is_valid() const { return valid_; }
+    Board& board() { return board_; }
+    const std::vector<std::shared_ptr<Tank>>& tanks() const { return tanks_; }
+
+    // Every tank takes its scripted action, then both shells steps, like a round of the game
+    void playRound(size_t round)
+    {
+        for (size_t i = 0; i < tanks_.size(); ++i)
+        {
+            ActionRequest action = kScript[(round + i) % kScript.size()];
+            board_.executeTankAction(tanks_[i], action);
+        }
+        board_.doShellsStep(false);
+        board_.doShellsStep(true);
+    }
+
+    // Every tank shoots whenever its cooldown allows and turns in between, filling the board with shells
+    void fireVolleys(size_t rounds)
+    {
+        for (size_t round = 0; round < rounds; ++round)
+        {
+            for (const auto& tank : tanks_)
+            {
+                ActionRequest action = round % 4 == 0 ? ActionRequest::Shoot : ActionRequest::RotateLeft45;
+                board_.executeTankAction(tank, action);
+            }
+            board_.doShellsStep(false);
+            board_.doShellsStep(true);
+        }
+    }
+
+private:
+    ConcretePlayerFactory player_factory_;
+    ConcreteTankAlgorithmFactory algorithm_factory_;
+    Board board_;
+    std::vector<std::shared_ptr<Tank>> tanks_;
+    bool valid_ = false;
+};
@@ -0,0 +1,100 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <future>
+#include <memory>
+#include <optional>
+#include <utility>
+#include <vector>
+
+#include "ActionRequest.h"
+#include "TankAlgorithm.h"
+#include "phase_profiler.h"
+#include "thread_pool.h"
+
+
+// A tank's action for the round, DoNothing in place of an algorithm that ran out of time
+struct TimedAction
+{
+    ActionRequest action = ActionRequest::DoNothing;
+    bool timed_out = false;
+};
+
+// Asks the tanks' algorithms for their actions within the time budgets, a zero budget is no limit.
+// With more than one thread the calls of a round overlap, the algorithms only touch their own state while choosing,
+// and the actions still come back in tank order, so the game plays out the same.
+// With a budget, every call runs on a worker and the game waits for it until the deadline at most, one call at a time,
+// or with more than one thread, up to that many calls of the round together, the workers reused from call to call.
+// A call past its deadline is left running on its worker, which no other call gets meanwhile, and its tank does nothing
+// until it returns, then its action is dropped and an algorithm that is a DroppedActionListener is told so.
+// A tank that used up its game budget does nothing for the rest of the game.
+// The calls still running when the runner is destroyed are waited for, so it must go before the algorithms, and an
+// algorithm that never returns blocks the destruction. A call can't be stopped from outside, and abandoning it would
+// leave it running on an algorithm that is about to be destroyed.
+class AlgorithmRunner
+{
+public:
+    AlgorithmRunner() = default;
+    AlgorithmRunner(size_t tanks_count, std::chrono::nanoseconds action_budget, std::chrono::nanoseconds game_budget,
+                    size_t threads = 1, PhaseProfiler* profiler = nullptr);
+
+    AlgorithmRunner(const AlgorithmRunner&) = delete;
+    AlgorithmRunner& operator=(const AlgorithmRunner&) = delete;
+    AlgorithmRunner(AlgorithmRunner&&) = default;
+    AlgorithmRunner& operator=(AlgorithmRunner&&) = default;
+
+    bool enforced() const { return action_budget_.count() > 0 || game_budget_.count() > 0; }
+
+    // One call at a time
+    TimedAction getAction(size_t tank_no, TankAlgorithm& algorithm);
+
+    // The actions of a round, in tank order, a null algorithm isn't asked
+    void getActions(const std::vector<TankAlgorithm*>& algorithms, std::vector<TimedAction>& r_actions);
+
+    size_t timeouts() const { return timeouts_; }
+
+private:
+    using CallResult = std::pair<ActionRequest, std::chrono::nanoseconds>;
+
+    struct TankState
+    {
+        std::chrono::nanoseconds used{0}; // Time charged to the tank's game budget
+        std::future<CallResult> late_call;
+        TankAlgorithm* late_algorithm = nullptr;  // Told its action was dropped once the late call returns
+        std::chrono::nanoseconds late_charged{0}; // Already charged for the late call, its deadline
+        std::unique_ptr<ThreadPool> late_worker;  // The worker the late call holds
+    };
+
+    struct BudgetedCall
+    {
+        std::future<CallResult> call;
+        TankAlgorithm* algorithm = nullptr;
+        std::unique_ptr<ThreadPool> worker;
+        std::chrono::nanoseconds budget{0};
+        std::chrono::steady_clock::time_point deadline;
+    };
+
+    ActionRequest callInPlace(size_t tank_no, TankAlgorithm& algorithm);
+
+    // Hands the call to a worker, or returns nullopt if the tank has no time left to be asked
+    std::optional<BudgetedCall> startCall(size_t tank_no, TankAlgorithm& algorithm);
+    TimedAction finishCall(size_t tank_no, BudgetedCall&& budgeted_call);
+    TimedAction timedOut();
+
+    // Settles the tank's late call if it has returned, false while it's still running
+    bool settleLateCall(size_t tank_no);
+    std::unique_ptr<ThreadPool> takeWorker();
+    void recordTime(size_t tank_no, std::chrono::nanoseconds elapsed);
+
+    std::chrono::nanoseconds action_budget_{0};
+    std::chrono::nanoseconds game_budget_{0};
+    size_t threads_ = 1;
+    std::vector<TankState> tanks_;
+    std::unique_ptr<ThreadPool> pool_; // Runs the calls of a round at once, when there's no budget
+    std::vector<std::unique_ptr<ThreadPool>> idle_workers_;
+    std::vector<std::optional<BudgetedCall>> round_calls_;
+    PhaseProfiler* profiler_ = nullptr;
+    size_t timeouts_ = 0;
+};
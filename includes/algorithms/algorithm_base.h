@@ -1,18 +1,21 @@
 #pragma once
 
 #include <optional>
+#include <span>
 #include <unordered_map>
 #include <unordered_set>
 #include <vector>
 
 #include "TankAlgorithm.h"
-#include "cell.h"
+#include "algorithms/ray_table.h"
+#include "dropped_action_listener.h"
+#include "grid.h"
 #include "smart_battle_info.h"
 #include "tank.h"
 
 class BattleInfo;
 
-class AlgorithmBase : public TankAlgorithm
+class AlgorithmBase : public TankAlgorithm, public DroppedActionListener
 {
 public:
     virtual ~AlgorithmBase() = default;
@@ -27,26 +30,54 @@ public:
     virtual ActionRequest getAction() override;
     virtual void updateBattleInfo(BattleInfo& info) override;
 
+    // Our model already played the action getAction returned, takes it back to doing nothing instead
+    virtual void actionDropped() override;
+
 protected:
     virtual ActionRequest getActionImpl() = 0;
 
     virtual void extendBattleInfoProcessing(SmartBattleInfo&) {}
     void handleTankMovement(const ActionRequest action);
     virtual void extendShootActionHandling() {}
+    virtual void extendDroppedActionHandling() {} // Takes back the rest of a dropped action, before our tank is restored
 
     bool hasLineOfSightToOpponent(const Position& start_pos, Direction dir, Position& r_opponent_pos) const;
     bool isShellIncoming(const Position& pos, Position* r_shell_pos = nullptr, Direction* r_shell_possible_dir = nullptr, size_t shell_max_distance = 8) const;
     std::optional<ActionRequest> getEvadeActionIfShellIncoming(size_t shell_max_distance = 8) const; // 8 because our grid may be outdated, and we might need time to evade
 
+    // Builds the ray table if the grid changed since it was last built. Until then, line of sight and
+    // shell checks walk the grid, which is cheaper for the few checks made outside a search.
+    // Boards whose table would take more than ray_table_max_mb always walk.
+    void prepareRays();
+
+    // The cells that changed since clearChangedCells(), by battle infos or by our own moves.
+    // Past an eighth of the board they aren't listed anymore, and allCellsChanged() is set.
+    std::span<const size_t> changedCells() const { return changed_cells_; }
+    bool allCellsChanged() const { return all_cells_changed_; }
+    void clearChangedCells();
+
+    bool hasLineOfSightFromRays(const Position& start_pos, Direction dir, Position& r_opponent_pos) const;
+    bool isShellIncomingFromRays(const Position& pos, Position* r_shell_pos, Direction* r_shell_possible_dir, size_t shell_max_distance) const;
+
     virtual void printTankInfo() const;         // Print tank's known information, for debugging purposes
     virtual void extendPrintTankInfo() const {} // Extend the tank info printing, for derived classes
 
     int player_index_;
     int tank_index_;
-    std::shared_ptr<Tank> tank_;
-    std::vector<std::vector<Cell>> grid_;
-    std::unordered_map<Position, std::unordered_set<Direction>> shell_possible_directions_;
+    Tank* tank_ = nullptr; // Owned by grid_
+    Grid grid_; // Refreshed in place on every battle info, only the cells that changed are rebuilt
+    std::vector<size_t> refreshed_cells_; // The cells the last battle info rebuilt
+    ShellDirections shell_possible_directions_;
+    RayTable rays_; // Line of sight and shell threat distances over grid_, kept in sync with it once built
     size_t width_;
     size_t height_;
     size_t turns_till_next_battle_info_ = 0; // Turns until the next GetBattleInfo request
+    Tank::RuntimeState pre_action_state_{}; // Our tank before the last action getAction returned
+    size_t pre_action_turns_till_battle_info_ = 0; // And turns_till_next_battle_info_, a dropped GetBattleInfo brought nothing
+
+private:
+    void markCellChanged(size_t index);
+
+    std::vector<size_t> changed_cells_;
+    bool all_cells_changed_ = true;
 };
@@ -3,63 +3,17 @@
 #include <concepts>
 #include <type_traits>
 #include <unordered_map>
+#include <vector>
 
 #include "ActionRequest.h"
 #include "SatelliteView.h"
 #include "cell.h"
+#include "grid.h"
+#include "satellite_snapshot.h"
 #include "types/direction.h"
 #include "types/position.h"
 
 
-// Represents a state in BFS with position and direction
-struct BFSState
-{
-    Position pos;
-    Direction dir;
-    size_t shells_left;
-    size_t cooldown;
-    std::unordered_map<Position, size_t> walls_damage; // damage dealt to walls in search
-
-    bool operator==(const BFSState& other) const
-    {
-        return pos == other.pos && dir == other.dir &&
-               shells_left == other.shells_left && cooldown == other.cooldown &&
-               walls_damage == other.walls_damage;
-    }
-
-    bool operator!=(const BFSState& other) const
-    {
-        return !(*this == other);
-    }
-};
-
-// Hash specialization for BFSState to use in unordered containers
-namespace std
-{
-template <>
-struct hash<BFSState>
-{
-    size_t operator()(const BFSState& state) const
-    {
-        size_t h = 0;
-        h ^= hash<Position>()(state.pos);
-        h ^= (hash<int>()(static_cast<int>(state.dir)) << 1);
-        h ^= (hash<size_t>()(state.shells_left) << 2);
-        h ^= (hash<size_t>()(state.cooldown) << 3);
-
-        // Hash the walls_damage map (order-independent)
-        size_t wall_hash = 0;
-        for (const auto& [pos, dmg] : state.walls_damage)
-        {
-            wall_hash ^= (hash<Position>()(pos) ^ (hash<size_t>()(dmg) << 1));
-        }
-        h ^= (wall_hash << 4);
-
-        return h;
-    }
-};
-} // namespace std
-
 // Concept to check if a triple of (Map, Key, Value) is compatible with a map interface
 template <typename Map, typename Key, typename Value>
 concept CompatibleMap =
@@ -85,7 +39,7 @@ Value getOrDefault(const Map& map, const Key& key, const Value& default_value)
     return default_value;
 }
 
-void printGrid(const std::vector<std::vector<Cell>>& grid);
+void printGrid(const Grid& grid);
 
 const std::vector<Direction>& getAllDirections();
 Direction getOppositeDirection(Direction dir);
@@ -99,8 +53,18 @@ Position forwardPosition(const Position& pos, Direction dir, size_t width, size_
 Position backwardPosition(const Position& pos, Direction dir, size_t width, size_t height, size_t steps = 1);
 size_t getDistance(const Position& from, const Position& to, Direction dir, size_t width, size_t height);
 
-size_t getNumberOfShellsInGrid(const std::vector<std::vector<Cell>>& grid);
-bool isBlockedByWall(const std::vector<std::vector<Cell>>& grid, const Position& from, Direction dir, size_t steps);
+size_t getNumberOfShellsInGrid(const Grid& grid);
+bool isBlockedByWall(const SatelliteSnapshot& snapshot, const Position& from, Direction dir, size_t steps);
+
+// Reads the whole view once into the snapshot, reusing its buffer
+void captureSatelliteView(const SatelliteView& satellite_view, size_t width, size_t height, SatelliteSnapshot& r_snapshot);
+
+// Refills the grid in place, reusing the memory of its previous contents
+void reconstructGridFromSnapshot(Grid& r_grid, const SatelliteSnapshot& snapshot, int player_index, size_t num_shells,
+                                 Position& r_tank_pos);
 
-std::vector<std::vector<Cell>> reconstructGridFromSatelliteView(const SatelliteView& satellite_view, size_t height, size_t width,
-                                                                int player_index, size_t num_shells, Position& r_tank_pos);
\ No newline at end of file
+// Brings a grid reconstructed from an earlier snapshot of the same board up to date, rebuilding only the cells
+// that don't show what the snapshot does. The tank's own cell ('%') is always rebuilt. Returns false if the grid had
+// to be reconstructed whole, otherwise the rebuilt cells' indices are appended to r_changed_cells.
+bool refreshGridFromSnapshot(Grid& r_grid, const SatelliteSnapshot& snapshot, int player_index, size_t num_shells,
+                             Position& r_tank_pos, std::vector<size_t>& r_changed_cells);
\ No newline at end of file
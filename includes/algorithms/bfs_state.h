@@ -0,0 +1,116 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include "ActionRequest.h"
+#include "shell_directions.h"
+#include "types/direction.h"
+#include "types/position.h"
+
+
+// Represents a state in BFS, packed into 12 bytes.
+// The shells left are not stored, they are the shells at the start of the search minus the
+// number of hits in the walls damage set, as shooting walls is the only way to spend shells.
+struct BFSState
+{
+    uint32_t pos_index;       // Grid index of the position, y * width + x
+    uint32_t walls_damage_id; // Id of the interned set of walls damaged in search, 0 = no walls damaged
+    Direction dir;
+    uint8_t cooldown;
+};
+
+// A state reached by the search, with the action that led to it from its parent
+struct BFSNode
+{
+    BFSState state;
+    uint32_t parent; // Index of the parent node, the start node is its own parent
+    ActionRequest action;
+};
+
+// Interns the sets of (wall, hits) reached during a search, so states refer to them by a small id,
+// and states with equal damage sets have equal ids no matter the order the walls were hit in.
+class WallsDamageSets
+{
+public:
+    WallsDamageSets();
+
+    void clear();
+
+    size_t hits(uint32_t id, uint32_t wall_index) const;
+    size_t totalHits(uint32_t id) const { return total_hits_[id]; }
+
+    // Returns the id of the set with one more hit on the given wall
+    uint32_t withHit(uint32_t id, uint32_t wall_index);
+
+private:
+    using DamageSet = std::vector<std::pair<uint32_t, uint8_t>>; // Sorted (wall index, hits)
+
+    std::vector<DamageSet> sets_;
+    std::vector<size_t> total_hits_;
+    std::map<DamageSet, uint32_t> ids_;
+    std::unordered_map<uint64_t, uint32_t> transitions_; // (id, wall index) -> id with one more hit
+};
+
+// The memory a search works in, which grows with the board. It's only needed while a search runs, so each thread
+// keeps one that all the tanks searching on it reuse, instead of every tank keeping its own.
+struct SearchScratch
+{
+    std::vector<BFSNode> nodes;                       // Reached nodes in BFS order, doubles as the BFS queue
+    std::vector<uint64_t> visited_bits;               // Visited bit per (pos, dir, cooldown), for states with no walls damaged
+    std::unordered_set<uint64_t> visited_with_damage; // Visited states with walls damaged, a sparse overlay over visited_bits
+    WallsDamageSets walls_damage_sets;
+};
+
+// A bit per index that remembers which bits it set, so clearing it only touches those and not the whole board
+class SparseBits
+{
+public:
+    // Clears the set bits, or sizes the bits to the given size if it changed
+    void reset(size_t size);
+
+    void set(size_t index)
+    {
+        if (!bits_[index])
+        {
+            bits_[index] = true;
+            set_indices_.push_back(index);
+        }
+    }
+
+    bool operator[](size_t index) const { return bits_[index]; }
+
+private:
+    std::vector<bool> bits_;
+    std::vector<size_t> set_indices_;
+};
+
+// What a finished search read and returned, so the next search from the same start state can take its result as is
+// when none of the cells it read changed since. The cells that changed are tracked by AlgorithmBase.
+// Only the whole result is reused, if anything it read changed the next search runs again from scratch.
+struct SearchRecord
+{
+    bool valid = false;
+    BFSState start_state{};
+    size_t start_ammo = 0;
+    size_t width = 0;
+    size_t height = 0;
+
+    bool found = false;
+    std::vector<ActionRequest> path; // Valid if found
+    Position target;                 // Valid if found
+
+    // The inputs of the search besides the grid, as they were when it ran
+    std::unordered_map<Position, size_t> walls_damage;
+    std::unordered_set<Position> reserved_positions;
+    ShellDirections shell_possible_directions;
+
+    // The parts of the grid the search depended on
+    SparseBits cells_read; // Per grid index, cells the search tried to enter or shoot
+    SparseBits rays_read;  // Per (grid index, dir), line of sight checks made by the search
+};
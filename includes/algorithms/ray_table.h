@@ -0,0 +1,95 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <vector>
+
+#include "grid.h"
+#include "shell_directions.h"
+#include "types/direction.h"
+#include "types/position.h"
+
+
+// Per cell and direction distances along the board's (wrapping) rays, so line of sight and shell threat
+// checks are a lookup instead of a walk.
+// Built from scratch for a new grid, and updated per cell when a few cells change, which only touches the
+// cells behind each of them up to the previous wall or tank.
+// A cell costs 34 bytes: what it holds for the rays, and a u16 distance per plane. The rays themselves are
+// stepped through on the fly. Distances past 65534 can't be stored and read as no_hit.
+class RayTable
+{
+public:
+    static constexpr uint32_t no_hit = std::numeric_limits<uint32_t>::max();
+
+    RayTable() = default;
+
+    // What the table costs per board cell, for every tank that keeps one
+    static constexpr size_t bytesPerCell() { return sizeof(CellState) + sizeof(Distance) * 16; }
+
+    bool built() const { return built_; }
+    void invalidate() { built_ = false; }
+
+    void rebuild(const Grid& grid, const ShellDirections& shell_possible_directions);
+    void updateCell(const Grid& grid, const ShellDirections& shell_possible_directions, size_t index);
+
+    // Updates the cells, or rebuilds the table when so many changed that it's cheaper
+    void updateCells(const Grid& grid, const ShellDirections& shell_possible_directions, std::span<const size_t> indices);
+
+    // Distance to the first wall or tank in front of the cell, no_hit if the ray never meets one
+    uint32_t blockerDistance(size_t index, Direction dir) const
+    {
+        return widen(planes_[static_cast<size_t>(dir)][index]);
+    }
+
+    // Distance to the closest shell behind the cell that may be flying in `dir` with no wall in between, no_hit if none
+    uint32_t shellDistance(size_t index, Direction dir) const
+    {
+        return widen(planes_[8 + static_cast<size_t>(dir)][index]);
+    }
+
+private:
+    using Distance = uint16_t;
+    static constexpr Distance kFar = std::numeric_limits<Distance>::max(); // Stored for no_hit
+
+    static uint32_t widen(Distance distance) { return distance == kFar ? no_hit : distance; }
+    static Distance stepBehind(Distance ahead) { return ahead >= kFar - 1 ? kFar : static_cast<Distance>(ahead + 1); }
+
+    enum class RayCell : uint8_t
+    {
+        Pass, // The ray goes on
+        Hit,  // The ray found what it looks for
+        Stop  // The ray is blocked before finding anything
+    };
+
+    // What a cell holds, as far as the rays are concerned
+    static constexpr uint8_t kBlocker = 1; // A wall or a tank, line of sight stops here
+    static constexpr uint8_t kWall = 2;    // Shells behind it can't reach the cells ahead
+    struct CellState
+    {
+        uint8_t flags = 0;
+        DirectionSet shell_directions; // The directions a shell here may fly in, empty with no shell
+    };
+
+    static CellState cellState(const Grid& grid, const ShellDirections& shell_possible_directions, size_t index);
+    static RayCell rayCell(size_t plane, const CellState& state);
+
+    // Line of sight looks forward, shell threat looks back for shells flying toward the cell
+    static Direction step(size_t plane);
+    size_t next(size_t plane, size_t index) const;
+    size_t previous(size_t plane, size_t index) const;
+    Distance distanceFrom(size_t plane, size_t ahead) const;
+
+    void buildPlane(size_t plane);
+    void updatePlane(size_t plane, size_t index);
+
+    bool built_ = false;
+    size_t width_ = 0;
+    size_t height_ = 0;
+    size_t size_ = 0;
+    std::vector<CellState> cells_;
+    std::array<std::vector<Distance>, 16> planes_; // 0-7: line of sight per direction, 8-15: shell threat per direction
+    std::vector<bool> visited_;                     // Scratch for buildPlane
+};
@@ -1,14 +1,16 @@
 #pragma once
 
+#include <cstdint>
 #include <queue>
 #include <unordered_map>
+#include <unordered_set>
+#include <vector>
 
 #include "algorithm_base.h"
 #include "algorithm_utils.h"
+#include "bfs_state.h"
 #include "smart_battle_info.h"
 
-struct BFSState;
-
 class SmartAlgorithm : public AlgorithmBase
 {
 public:
@@ -27,36 +29,30 @@ protected:
     virtual void extendBattleInfoProcessing(SmartBattleInfo& info) override;
     virtual void extendPrintTankInfo() const override;
     virtual void extendShootActionHandling() override;
+    virtual void extendDroppedActionHandling() override;
 
 private:
     std::optional<ActionRequest> findFirstSafeActionToOpponent();
+    std::optional<ActionRequest> runSearch(const BFSState& start_state);
 
-    void tryForwardMove(std::queue<BFSState>& q,
-                        std::unordered_map<BFSState, std::pair<BFSState, ActionRequest>>& parent,
-                        std::unordered_set<BFSState>& visited,
-                        const BFSState& current);
-
-    void tryRotations(std::queue<BFSState>& q,
-                      std::unordered_map<BFSState, std::pair<BFSState, ActionRequest>>& parent,
-                      std::unordered_set<BFSState>& visited,
-                      const BFSState& current);
+    // Reusing the previous search
+    void recordSearch(const BFSState& start_state, std::optional<ActionRequest> result);
+    bool canReusePreviousSearch(const BFSState& start_state) const;
+    bool isPreviousSearchAffectedBy(const Position& changed_pos) const;
 
-    void tryGetBattleInfo(std::queue<BFSState>& q,
-                          std::unordered_map<BFSState, std::pair<BFSState, ActionRequest>>& parent,
-                          std::unordered_set<BFSState>& visited,
-                          const BFSState& current);
+    void resetSearch();
+    void pushState(const BFSState& state, uint32_t parent, ActionRequest action);
+    size_t visitedBitIndex(const BFSState& state) const;
+    Position statePosition(const BFSState& state) const;
 
-    void tryShootingAWall(std::queue<BFSState>& q,
-                          std::unordered_map<BFSState, std::pair<BFSState, ActionRequest>>& parent,
-                          std::unordered_set<BFSState>& visited,
-                          const BFSState& current);
+    void tryForwardMove(const BFSState& current, uint32_t current_index);
+    void tryRotations(const BFSState& current, uint32_t current_index);
+    void tryGetBattleInfo(const BFSState& current, uint32_t current_index);
+    void tryShootingAWall(const BFSState& current, uint32_t current_index);
 
     bool isCellEmptyInState(const BFSState& state, const Position& pos) const;
 
-    ActionRequest handleLineOfSightToOpponent(BFSState& current,
-                                              std::unordered_map<BFSState, std::pair<BFSState, ActionRequest>>& parent,
-                                              const BFSState& start_state,
-                                              const Position& opponent_pos);
+    ActionRequest handleLineOfSightToOpponent(uint32_t node_index, const Position& opponent_pos);
 
     std::unordered_set<Position> computeReservedPositions(bool include_shooting_lane = true);
 
@@ -65,4 +61,8 @@ private:
     Position cached_target_;
     std::unordered_map<Position, size_t> total_walls_damage_; // Wall's position -> number of hits it has taken
     std::unordered_map<Position, size_t> local_walls_damage_; // Wall's position -> number of hits we made to it since last GetBattleInfo
-};
\ No newline at end of file
+
+    SearchScratch* search_ = nullptr; // The scratch of the thread running the search, set by resetSearch
+    size_t search_start_ammo_ = 0;
+    SearchRecord previous_search_;
+};
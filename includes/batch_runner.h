@@ -0,0 +1,50 @@
+#pragma once
+
+#include <cstddef>
+#include <map>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "PlayerFactory.h"
+#include "TankAlgorithmFactory.h"
+#include "global_config.h"
+
+
+// Aggregated outcome of all the games in a batch
+struct BatchSummary
+{
+    size_t games = 0;
+    size_t failed = 0; // Boards that couldn't be loaded, or games that threw
+    size_t ties = 0;
+    std::map<int, size_t> wins; // player_id -> number of games won
+    size_t timeouts = 0;        // Algorithm calls cut off by the time budgets, over all the games
+
+    void print(std::ostream& out) const;
+};
+
+// Plays many boards concurrently, every board in its own headless GameManager,
+// on a fixed-size pool of worker threads
+class BatchRunner
+{
+public:
+    BatchRunner(const PlayerFactory& playerFactory, const TankAlgorithmFactory& algorithmFactory, size_t num_threads,
+                bool record_replays = false, size_t action_threads = config::get<size_t>("action_threads"));
+
+    BatchRunner(const BatchRunner&) = delete;
+    BatchRunner& operator=(const BatchRunner&) = delete;
+    BatchRunner(BatchRunner&&) = delete;
+    BatchRunner& operator=(BatchRunner&&) = delete;
+
+    // Expands directories into the board files they contain, skipping previous output files
+    static std::vector<std::string> collectBoardFiles(const std::vector<std::string>& paths);
+
+    BatchSummary run(const std::vector<std::string>& board_files) const;
+
+private:
+    const PlayerFactory& playerFactory_;
+    const TankAlgorithmFactory& algorithmFactory_;
+    size_t num_threads_;
+    bool record_replays_;
+    size_t action_threads_; // Per game, for the tanks choosing their actions
+};
@@ -1,6 +1,8 @@
 #pragma once
 
+#include <cstdint>
 #include <map>
+#include <unordered_map>
 #include <unordered_set>
 #include <vector>
 
@@ -10,9 +12,12 @@
 #include "TankAlgorithmFactory.h"
 
 #include "cell.h"
+#include "cell_index_set.h"
 #include "direction.h"
 #include "game_info.h"
+#include "grid.h"
 #include "position.h"
+#include "satellite_snapshot.h"
 #include "tank.h"
 
 
@@ -35,34 +40,112 @@ public:
     const Cell& getCell(Position position) const;
     size_t getHeight() const;
     size_t getWidth() const;
-    std::vector<std::vector<Cell>>& grid();
-    const std::vector<std::vector<Cell>>& getGrid() const;
-    bool executeTankAction(std::shared_ptr<Tank> tank, ActionRequest& action);
+    Grid& grid();
+    const Grid& getGrid() const;
+    bool executeTankAction(const std::shared_ptr<Tank>& tank, ActionRequest& action);
     void doShellsStep(bool shells_only = true);
     void update();
     TankAlgorithm* getAlgorithm(int player_id, int tank_id);
 
+    // Zobrist hash of the whole state, equal states hash the same in every build and run.
+    // The cells are hashed incrementally as objects come and go, the few tanks' runtime state on every call.
+    uint64_t hash() const;
+    uint64_t computeHash() const; // From scratch, for checking the incremental hash
+
+    // Lookahead through the real game rules: take a checkpoint, play actions and steps, then roll back to it.
+    // While a checkpoint is open every change is journaled, so rolling back undoes only what changed since,
+    // instead of copying the board. Checkpoints nest, and are closed in reverse order by rollback() or commit().
+    // Take them between rounds, after the shells-only step, and note that GetBattleInfo doesn't reach the
+    // players while one is open, so simulating ahead can't leak into their state.
+    struct Checkpoint
+    {
+        size_t journal_size;
+        size_t tank_states_size;
+        size_t deferred_releases_size;
+        uint64_t cells_hash;
+    };
+    Checkpoint checkpoint();
+    void rollback(const Checkpoint& checkpoint);
+    void commit(const Checkpoint& checkpoint); // Keeps the changes, the outer checkpoints can still undo them
+
 private:
     void updateActiveShells();
     void resolveCollisions(Cell& cell);
     void onExplosion(Cell& cell);
-    bool moveTankBackward(std::shared_ptr<Tank> tank, const Position& current_pos);
-    bool rotateTank(std::shared_ptr<Tank> tank, ActionRequest action);
-    bool shoot(std::shared_ptr<Tank> tank, const Position& current_pos);
-    bool getBattleInfo(std::shared_ptr<Tank> tank);
-    bool doNothing(std::shared_ptr<Tank> tank);
-    bool moveTankForward(std::shared_ptr<Tank> tank, const Position& current_pos);
-    bool handleBackMovement(std::shared_ptr<Tank> tank, const Position& current_pos);
+    bool moveTankBackward(Tank& tank, const Position& current_pos);
+    bool rotateTank(Tank& tank, ActionRequest action);
+    bool shoot(Tank& tank, const Position& current_pos);
+    bool getBattleInfo(Tank& tank);
+    bool doNothing(Tank& tank);
+    bool moveTankForward(Tank& tank, const Position& current_pos);
+    bool handleBackMovement(Tank& tank, const Position& current_pos);
+    void recordOldTankPosition(const Position& pos, Tank& tank);
+    void addObjectToCell(const Position& pos, GameObjectInterface* object);
+    void removeObjectFromCell(const Position& pos, GameObjectInterface* object);
+    void refreshSnapshot();
+    void toggleCellHash(const Cell& cell);
+    void removeObjectsFromCell(Cell& cell, ObjectType type);
+    void releaseObject(GameObjectInterface* object);
+    void weakenWall(Wall& wall);
+    void setActiveShell(size_t slot, const Position& pos, Shell* shell);
+    bool journaling() const { return open_checkpoints_ > 0; }
+    uint64_t tanksStateHash() const;
+    void addActiveShell(const Position& pos, Shell* shell);
+    void removeActiveShell(size_t slot);
 
     const PlayerFactory& playerFactory_;
     const TankAlgorithmFactory& algorithmFactory_;
 
     size_t width_, height_;
-    std::vector<std::vector<Cell>> grid_;
-    std::vector<std::vector<Cell>> prev_grid_; // Previous state of the grid, used for GetBattleInfo
-    std::vector<std::pair<Position, std::shared_ptr<Shell>>> active_shells_;
-    std::unordered_set<Position> cells_to_update_;
-    std::unordered_map<Position, std::shared_ptr<Tank>> old_tanks_positions_;
+    Grid grid_;                          // Also owns the walls and mines
+    SatelliteSnapshot prev_snapshot_;    // Satellite image of the previous turn, used for GetBattleInfo
+    CellIndexSet snapshot_dirty_cells_;  // Cells changed since prev_snapshot_ was refreshed
+    std::vector<std::pair<Position, Shell*>> active_shells_; // Slot array, indexed by Shell::slot(), null shell = free slot, shells owned by grid_
+    std::vector<size_t> free_shell_slots_;
+    CellIndexSet cells_to_update_;
+    uint64_t cells_hash_ = 0; // Xor of the Zobrist keys of all the objects on the board
+    std::vector<std::pair<Position, Tank*>> old_tanks_positions_; // Tanks that moved this turn, by the position they left
     std::map<std::pair<size_t, size_t>, std::unique_ptr<TankAlgorithm>> algorithms_;
     std::map<int, std::pair<std::unique_ptr<Player>, std::vector<std::shared_ptr<Tank>>>> player_tanks_;
+
+    static constexpr size_t kNoShell = static_cast<size_t>(-1);
+
+    // Scratch space reused every step, so moving shells and tanks does not allocate
+    std::vector<Position> shell_destinations_;      // Per shell slot
+    std::vector<bool> crossing_shells_;             // Per shell slot
+    std::vector<size_t> next_shell_leaving_;        // Per shell slot, next shell leaving the same cell
+    std::vector<size_t> first_shell_leaving_;       // Per grid index, first shell leaving the cell
+    std::vector<GameObjectInterface*> destroyed_walls_;
+    std::vector<size_t> exploded_shell_slots_;
+
+    // A change to undo on rollback, only recorded while a checkpoint is open
+    struct JournalEntry
+    {
+        enum class Kind : uint8_t
+        {
+            ObjectAdded,     // object was added to the cell at index
+            ObjectRemoved,   // object was removed from the cell at index
+            ShellCreated,    // object was created, it's released on rollback
+            ActiveShellSet,  // slot index held (position, object) before
+            ShellSlotsGrown, // a slot was appended to active_shells_
+            FreeSlotPushed,  // a slot was pushed to free_shell_slots_
+            FreeSlotPopped,  // slot index was popped from free_shell_slots_
+            WallWeakened,    // object had value hits before
+            SnapshotChanged, // the snapshot char of cell index was value before
+        };
+
+        Kind kind;
+        size_t index = 0;
+        GameObjectInterface* object = nullptr;
+        Position position{};
+        size_t value = 0;
+    };
+
+    void journal(const JournalEntry& entry);
+    void undo(const JournalEntry& entry);
+
+    size_t open_checkpoints_ = 0;
+    std::vector<JournalEntry> journal_;
+    std::vector<std::pair<Tank*, Tank::RuntimeState>> tank_states_; // All the tanks, per open checkpoint
+    std::vector<GameObjectInterface*> deferred_releases_; // Objects released while journaling, kept alive for a rollback
 };
@@ -0,0 +1,36 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+
+struct BoardGeneratorOptions
+{
+    size_t width = 10;
+    size_t height = 10;
+    double wall_density = 0.1; // Share of the cells that get a wall
+    double mine_density = 0.03;
+    size_t players = 2; // 1 to 9
+    size_t tanks_per_player = 1;
+    size_t max_steps = 1000;
+    size_t num_shells = 10;
+    uint64_t seed = 0;
+};
+
+// Generates boards in the input file format, for inputs larger than anyone would draw by hand.
+// Walls, mines and tanks are scattered at random over distinct cells, and the same options always give the same board.
+class BoardGenerator
+{
+public:
+    explicit BoardGenerator(const BoardGeneratorOptions& options) : options_(options) {}
+
+    // Too many objects for the board, or an unsupported number of players
+    bool is_valid() const;
+
+    std::string generate() const;
+    bool writeToFile(const std::string& filename) const;
+
+private:
+    BoardGeneratorOptions options_;
+};
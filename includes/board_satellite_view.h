@@ -1,16 +1,20 @@
 #pragma once
 
-#include <vector>
+#include <algorithm>
+#include <cstring>
+#include <span>
 
 #include "SatelliteView.h"
+#include "bulk_satellite_view.h"
 #include "cell.h"
+#include "satellite_snapshot.h"
 
-class BoardSatelliteView : public SatelliteView
+class BoardSatelliteView final : public SatelliteView, public BulkSatelliteView
 {
 public:
     virtual ~BoardSatelliteView() = default;
-    BoardSatelliteView(const std::vector<std::vector<Cell>>& grid, const Position tank_position)
-        : grid_(grid), tank_position_{tank_position} {}
+    BoardSatelliteView(const SatelliteSnapshot& snapshot, const Position tank_position)
+        : snapshot_(snapshot), tank_position_{tank_position} {}
 
     BoardSatelliteView(const BoardSatelliteView&) = delete;
     BoardSatelliteView& operator=(const BoardSatelliteView&) = delete;
@@ -21,14 +25,41 @@ public:
 
     char getObjectAt(size_t x, size_t y) const override
     {
-        if (x >= grid_.size() || y >= grid_[0].size())
+        if (x >= snapshot_.width() || y >= snapshot_.height())
             return '&';
 
         if (Position(x, y) == tank_position_)
             return '%';
 
-        const auto& cell = grid_[x][y];
+        return snapshot_.at(x, y);
+    }
+
+    void copyTo(std::span<char> buffer, size_t width, size_t height) const override
+    {
+        if (width == snapshot_.width() && height == snapshot_.height())
+        {
+            std::memcpy(buffer.data(), snapshot_.data(), width * height);
+        }
+        else
+        {
+            // Asked for a different size, whatever is outside the board is '&'
+            std::fill(buffer.begin(), buffer.begin() + width * height, '&');
+            size_t copy_width = std::min(width, snapshot_.width());
+            for (size_t y = 0; y < std::min(height, snapshot_.height()); ++y)
+            {
+                std::memcpy(buffer.data() + y * width, snapshot_.row(y).data(), copy_width);
+            }
+        }
+
+        if (tank_position_.first < width && tank_position_.second < height)
+        {
+            buffer[tank_position_.second * width + tank_position_.first] = '%';
+        }
+    }
 
+    // The char a satellite sees for the cell, ignoring which tank asked for the view
+    static char cellToChar(const Cell& cell)
+    {
         if (cell.has(ObjectType::Wall))
             return '#';
 
@@ -40,15 +71,14 @@ public:
 
         if (cell.has(ObjectType::Tank))
         {
-            const auto tank_obj = cell.getObjectByType(ObjectType::Tank);
-            auto tank_ptr = std::static_pointer_cast<Tank>(tank_obj);
-            return '0' + tank_ptr->playerId();
+            const auto* tank = static_cast<const Tank*>(cell.getObjectByType(ObjectType::Tank));
+            return '0' + tank->playerId();
         }
 
         return ' ';
     }
 
 private:
-    const std::vector<std::vector<Cell>>& grid_;
+    const SatelliteSnapshot& snapshot_;
     const Position tank_position_;
 };
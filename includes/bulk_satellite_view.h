@@ -0,0 +1,16 @@
+#pragma once
+
+#include <cstddef>
+#include <span>
+
+
+// Optional extension of SatelliteView, for views that can hand out their whole image in one go.
+// Readers look for it with dynamic_cast, and fall back to getObjectAt for views that don't have it.
+class BulkSatelliteView
+{
+public:
+    virtual ~BulkSatelliteView() = default;
+
+    // Fills a row-major buffer of width * height chars, each one what getObjectAt(x, y) would return
+    virtual void copyTo(std::span<char> buffer, size_t width, size_t height) const = 0;
+};
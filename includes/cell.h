@@ -1,37 +1,64 @@
 #pragma once
 
-#include <memory>
-#include <unordered_map>
+#include <array>
+#include <cstdint>
+#include <span>
 #include <vector>
 
 #include "game_object_interface.h"
 #include "mine.h"
-#include "position.h"
 #include "shell.h"
 #include "tank.h"
 #include "wall.h"
 
+// A cell holds non-owning handles to the objects in it, the objects are owned by the Board (tanks and shells)
+// or by the Grid (walls, mines, and whatever a player reconstructs from a satellite view).
+// Handles are kept grouped by type, inline for the usual one or two objects, so moving an object in or out of
+// a cell does not allocate. A cell doesn't know where it is, the Grid maps its index to a position.
 class Cell
 {
 public:
     Cell() = default;
-    Cell(Position position, std::shared_ptr<GameObjectInterface> object = nullptr);
+    ~Cell();
 
-    Position& position();
-    const Position& position() const;
+    Cell(const Cell&) = delete;
+    Cell& operator=(const Cell&) = delete;
+    Cell(Cell&& other) noexcept;
+    Cell& operator=(Cell&& other) noexcept;
 
-    void addObject(std::shared_ptr<GameObjectInterface> obj);
-    void removeObject(std::shared_ptr<GameObjectInterface> obj);
+    void addObject(GameObjectInterface* object);
+    void removeObject(GameObjectInterface* object);
     void removeObjectsByType(ObjectType type);
+    void clear();
 
-    std::shared_ptr<GameObjectInterface> getObjectByType(ObjectType type) const;
-    const std::vector<std::shared_ptr<GameObjectInterface>>& getObjectsByType(ObjectType type) const;
-    size_t getObjectsCount() const;
+    GameObjectInterface* getObjectByType(ObjectType type) const;
+    std::span<GameObjectInterface* const> getObjectsByType(ObjectType type) const;
+    size_t getObjectsCount() const { return size_; }
 
-    bool has(ObjectType type) const;
-    bool empty() const;
+    bool has(ObjectType type) const { return occupancy_ & typeBit(type); }
+    bool empty() const { return occupancy_ == 0; }
+    uint8_t occupancy() const { return occupancy_; } // Bitmask of the object types in the cell
+
+    static constexpr uint8_t typeBit(ObjectType type) { return static_cast<uint8_t>(1u << static_cast<size_t>(type)); }
 
 private:
-    Position position_;
-    std::unordered_map<ObjectType, std::vector<std::shared_ptr<GameObjectInterface>>> objects_;
+    static constexpr size_t kObjectTypesCount = 4;
+    static constexpr size_t kInlineCapacity = 2; // A tank or a shell on a mine, or a shell hitting a tank
+
+    bool overflowing() const { return size_ > kInlineCapacity; }
+    GameObjectInterface** data() { return overflowing() ? overflow_->data() : inline_objects_.data(); }
+    GameObjectInterface* const* data() const { return overflowing() ? overflow_->data() : inline_objects_.data(); }
+    size_t typeBegin(ObjectType type) const;
+    void leaveOverflow();
+
+    uint8_t occupancy_ = 0; // Bit per ObjectType, set while the cell has objects of that type
+    uint8_t size_ = 0;
+    std::array<uint8_t, kObjectTypesCount> counts_{}; // Objects per type, stored in type order
+    // While there are too many objects to keep inline, they are all held in a vector behind a pointer instead,
+    // sharing the inline storage since every cell of a large board would pay for a field of its own
+    union
+    {
+        std::array<GameObjectInterface*, kInlineCapacity> inline_objects_{};
+        std::vector<GameObjectInterface*>* overflow_;
+    };
 };
@@ -0,0 +1,46 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+
+// Set of grid indices that is filled and drained every step without allocating,
+// a flag per cell to drop duplicates and the list of flagged cells in insertion order.
+class CellIndexSet
+{
+public:
+    CellIndexSet() = default;
+
+    void reset(size_t cells_count)
+    {
+        flags_.assign(cells_count, false);
+        indices_.clear();
+        indices_.reserve(cells_count);
+    }
+
+    void insert(size_t index)
+    {
+        if (!flags_[index])
+        {
+            flags_[index] = true;
+            indices_.push_back(index);
+        }
+    }
+
+    void clear()
+    {
+        for (size_t index : indices_)
+        {
+            flags_[index] = false;
+        }
+        indices_.clear();
+    }
+
+    bool empty() const { return indices_.empty(); }
+    std::vector<size_t>::const_iterator begin() const { return indices_.begin(); }
+    std::vector<size_t>::const_iterator end() const { return indices_.end(); }
+
+private:
+    std::vector<bool> flags_;
+    std::vector<size_t> indices_;
+};
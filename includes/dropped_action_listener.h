@@ -0,0 +1,14 @@
+#pragma once
+
+
+// Optional extension of TankAlgorithm, for algorithms that update their own model as they choose an action.
+// The runner looks for it with dynamic_cast, and tells the algorithm when the action it chose came too late and
+// was dropped, so the tank did nothing instead.
+class DroppedActionListener
+{
+public:
+    virtual ~DroppedActionListener() = default;
+
+    // Called once the late call has returned, before the algorithm is asked again
+    virtual void actionDropped() = 0;
+};
@@ -0,0 +1,62 @@
+#pragma once
+
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+#include "PlayerFactory.h"
+#include "TankAlgorithmFactory.h"
+#include "replay.h"
+#include "replay_player.h"
+#include "seed_algorithm.h"
+
+
+// Players for re-simulating a recorded game, no satellite view is ever looked at
+class ReplayPlayerFactory : public PlayerFactory
+{
+public:
+    virtual ~ReplayPlayerFactory() = default;
+    virtual std::unique_ptr<Player> create(int player_index, size_t x, size_t y, size_t max_steps, size_t num_shells) const override
+    {
+        return std::make_unique<ReplayPlayer>(player_index, x, y, max_steps, num_shells);
+    }
+};
+
+// Seeds every tank with the actions it was recorded taking, in the rounds it started alive.
+// The board creates the algorithms in play order, the order the tanks are recorded in, so use a fresh factory per game.
+class ReplayTankAlgorithmFactory : public TankAlgorithmFactory
+{
+public:
+    explicit ReplayTankAlgorithmFactory(const ReplayReader& recording) : seeds_(recording.tanks())
+    {
+        for (size_t round = 0; round < recording.rounds(); ++round)
+        {
+            for (size_t tank_no = 0; tank_no < recording.tanks(); ++tank_no)
+            {
+                ReplayAction replay_action = recording.action(round, tank_no);
+                if (replay_action.alive_at_start)
+                {
+                    seeds_[tank_no].push_back(replay_action.action.value_or(ActionRequest::DoNothing));
+                }
+            }
+        }
+    }
+    virtual ~ReplayTankAlgorithmFactory() = default;
+
+    virtual std::unique_ptr<TankAlgorithm> create(int player_index, int tank_index) const override
+    {
+        (void)player_index;
+        (void)tank_index;
+
+        if (next_tank_no_ >= seeds_.size())
+        {
+            throw std::invalid_argument("The board has more tanks than the recorded game");
+        }
+
+        return std::make_unique<SeedAlgorithm>(seeds_[next_tank_no_++]);
+    }
+
+private:
+    std::vector<std::vector<ActionRequest>> seeds_;
+    mutable size_t next_tank_no_ = 0;
+};
@@ -1,22 +1,28 @@
 #pragma once
 
 #include <cstddef>
+#include <functional>
 #include <map>
 #include <optional>
 
 #include "ActionRequest.h"
 #include "Player.h"
 #include "TankAlgorithm.h"
+#include "algorithm_runner.h"
 #include "board.h"
 #include "game_info.h"
+#include "game_options.h"
+#include "game_result.h"
 #include "output_logger.h"
+#include "phase_profiler.h"
+#include "replay.h"
 #include "tank.h"
 
 
 class GameManager
 {
 public:
-    GameManager(const PlayerFactory& playerFactory, const TankAlgorithmFactory& algorithmFactory);
+    GameManager(const PlayerFactory& playerFactory, const TankAlgorithmFactory& algorithmFactory, GameOptions options = {});
 
     GameManager(const GameManager&) = delete;
     GameManager& operator=(const GameManager&) = delete;
@@ -25,6 +31,15 @@ public:
 
     bool readBoard(const std::string& filename);
     void run();
+    const GameResult& result() const;
+
+    // Every tank's part in a round, in play order, as the output file and the replay record it
+    using RoundListener = std::function<void(size_t round, const std::vector<ReplayAction>& actions)>;
+    void setRoundListener(RoundListener listener);
+
+    // The loaded board and its tanks in play order, to check a recording against before running
+    const Board& board() const;
+    const std::vector<std::shared_ptr<Tank>>& tanks() const;
 
 private:
     static std::pair<std::string, std::string> splitFilename(const std::string& filename);
@@ -33,16 +48,27 @@ private:
     void getTanksActions();
     void checkActionsValidity();
     void handleTie();
-    std::string generateResultMessage() const;
+    GameResult generateResult() const;
     void logTankActions();
 
+    GameOptions options_;
     std::unique_ptr<Board> board_;
     std::vector<std::shared_ptr<Tank>> ordered_tanks_;
     size_t total_max_steps_;
     OutputLogger logger_;
+    ReplayWriter replay_;
+    PhaseProfiler profiler_;
+    std::string profile_filename_;
+    GameResult result_;
     std::optional<std::size_t> tie_countdown_;
     size_t half_steps_count_ = 0;
     std::vector<bool> was_alive_at_round_start_;
     std::vector<std::optional<ActionRequest>> actions_to_execute_;
     std::vector<bool> actions_validity_;
+    std::vector<TankAlgorithm*> round_algorithms_; // Null for the tanks not asked this round
+    std::vector<TimedAction> timed_actions_;
+    std::vector<bool> actions_timed_out_;
+    RoundListener round_listener_;
+    std::vector<ReplayAction> round_actions_; // For the round listener
+    AlgorithmRunner algorithm_runner_; // Last, the calls it waits for on destruction use the board's algorithms
 };
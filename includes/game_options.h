@@ -0,0 +1,20 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+
+#include "global_config.h"
+
+// Runtime options of a single game, selected from the command line
+struct GameOptions
+{
+    bool headless = false;      // Skip all the console output, only the output file is written
+    bool record_replay = false; // Also write a binary replay next to the output file
+    bool write_output = true;   // Off when re-simulating a recorded game, so its output file is left as is
+
+    // Time limits of the tanks' algorithms, per getAction call and for the whole game, 0 = no limit
+    std::chrono::milliseconds action_time_budget{config::get<int>("action_time_budget_ms")};
+    std::chrono::milliseconds game_time_budget{config::get<int>("game_time_budget_ms")};
+
+    size_t action_threads = config::get<size_t>("action_threads"); // The tanks choosing their actions at once, 1 = one by one
+};
@@ -0,0 +1,13 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+// Outcome of a finished game
+struct GameResult
+{
+    int winner = 0;      // Winning player id, 0 on a tie
+    size_t rounds = 0;   // Number of rounds played
+    std::string message; // The result line written to the output file
+    size_t timeouts = 0; // Actions replaced by DoNothing for running out of the time budgets
+};
@@ -0,0 +1,84 @@
+#pragma once
+
+#include <cstddef>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include "cell.h"
+#include "object_pool.h"
+#include "position.h"
+
+// Flat, row-major storage for the board cells.
+// Cell (x, y) lives at index y * width + x, so a lookup is a single indexed load,
+// and walking the grid row by row is a linear scan over contiguous memory.
+// The grid also owns the objects created through it, kept in a pool per object type, they live until
+// released or until the grid is reset or destroyed.
+class Grid
+{
+public:
+    Grid() = default;
+    Grid(size_t width, size_t height);
+
+    Grid(const Grid&) = delete;
+    Grid& operator=(const Grid&) = delete;
+
+    Grid(Grid&&) = default;
+    Grid& operator=(Grid&&) = default;
+
+    size_t width() const { return width_; }
+    size_t height() const { return height_; }
+    size_t size() const { return cells_.size(); }
+    bool empty() const { return cells_.empty(); }
+
+    size_t index(size_t x, size_t y) const { return y * width_ + x; }
+    size_t index(const Position& pos) const { return index(pos.first, pos.second); }
+    Position position(size_t index) const { return Position(index % width_, index / width_); }
+    size_t index(const Cell& cell) const { return static_cast<size_t>(&cell - cells_.data()); } // A cell of this grid
+
+    Cell& at(size_t x, size_t y) { return cells_[index(x, y)]; }
+    const Cell& at(size_t x, size_t y) const { return cells_[index(x, y)]; }
+
+    Cell& operator[](const Position& pos) { return cells_[index(pos)]; }
+    const Cell& operator[](const Position& pos) const { return cells_[index(pos)]; }
+
+    Cell& cell(size_t index) { return cells_[index]; }
+    const Cell& cell(size_t index) const { return cells_[index]; }
+
+    std::vector<Cell>::iterator begin() { return cells_.begin(); }
+    std::vector<Cell>::iterator end() { return cells_.end(); }
+    std::vector<Cell>::const_iterator begin() const { return cells_.begin(); }
+    std::vector<Cell>::const_iterator end() const { return cells_.end(); }
+
+    // Empties all the cells and destroys all the objects at once, keeping the memory when the size is the same
+    void reset(size_t width, size_t height);
+
+    // Creates an object owned by the grid, not placed in any cell
+    template <typename T, typename... Args>
+    T* create(Args&&... args)
+    {
+        return std::get<ObjectPool<T>>(pools_).create(std::forward<Args>(args)...);
+    }
+
+    // Creates an object owned by the grid and puts it in the cell
+    template <typename T, typename... Args>
+    T* emplace(const Position& pos, Args&&... args)
+    {
+        T* object = create<T>(std::forward<Args>(args)...);
+        (*this)[pos].addObject(object);
+        return object;
+    }
+
+    // Destroys an object created by the grid, it must not be in any cell anymore
+    template <typename T>
+    void release(T* object)
+    {
+        std::get<ObjectPool<T>>(pools_).destroy(object);
+    }
+
+private:
+    size_t width_ = 0;
+    size_t height_ = 0;
+    std::vector<Cell> cells_;
+    std::tuple<ObjectPool<Tank>, ObjectPool<Shell>, ObjectPool<Mine>, ObjectPool<Wall>> pools_;
+};
@@ -2,12 +2,15 @@
 
 #include <sstream>
 #include <string>
+#include <utility>
 #include <vector>
 
+// Collects the errors found while loading a board, and adds them to the input errors file under the board's name.
+// The file is emptied by the first logger of the run that has errors, so the games of a batch all keep theirs.
 class InputErrorLogger
 {
 public:
-    InputErrorLogger() = default;
+    explicit InputErrorLogger(std::string board_file) : board_file_(std::move(board_file)) {}
     ~InputErrorLogger();
 
     InputErrorLogger(const InputErrorLogger&) = delete;
@@ -26,5 +29,6 @@ public:
 private:
     void save_to_file(const std::string& filename) const;
 
+    std::string board_file_;
     std::vector<std::string> errors_; // Accumulate error messages
 };
@@ -0,0 +1,125 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <utility>
+#include <vector>
+
+
+// Pool of objects of a single type, carved out of fixed-size chunks.
+// Destroyed objects leave their slot to the next created one, and clear() destroys every live object at once
+// while keeping the chunks, so a pool that is filled and emptied over and over stops allocating.
+// Objects never move, the returned pointers stay valid until the object is destroyed or the pool is cleared.
+template <typename T>
+class ObjectPool
+{
+public:
+    ObjectPool() = default;
+    ~ObjectPool() { clear(); }
+
+    ObjectPool(const ObjectPool&) = delete;
+    ObjectPool& operator=(const ObjectPool&) = delete;
+
+    ObjectPool(ObjectPool&& other) noexcept
+        : chunks_(std::move(other.chunks_)),
+          free_slots_(std::move(other.free_slots_)),
+          used_(std::exchange(other.used_, 0)),
+          live_(std::exchange(other.live_, 0))
+    {
+        other.chunks_.clear();
+        other.free_slots_.clear();
+    }
+
+    ObjectPool& operator=(ObjectPool&& other) noexcept
+    {
+        if (this != &other)
+        {
+            clear();
+            chunks_ = std::move(other.chunks_);
+            free_slots_ = std::move(other.free_slots_);
+            used_ = std::exchange(other.used_, 0);
+            live_ = std::exchange(other.live_, 0);
+            other.chunks_.clear();
+            other.free_slots_.clear();
+        }
+        return *this;
+    }
+
+    template <typename... Args>
+    T* create(Args&&... args)
+    {
+        Slot* slot = nullptr;
+        if (!free_slots_.empty())
+        {
+            slot = free_slots_.back();
+            free_slots_.pop_back();
+        }
+        else
+        {
+            if (used_ == chunks_.size() * kChunkSize)
+            {
+                chunks_.push_back(std::make_unique<Slot[]>(kChunkSize));
+                if (free_slots_.capacity() < capacity())
+                {
+                    // So destroying never allocates, grown geometrically so large pools don't reallocate per chunk
+                    free_slots_.reserve(std::max(capacity(), 2 * free_slots_.capacity()));
+                }
+            }
+            slot = &chunks_[used_ / kChunkSize][used_ % kChunkSize];
+            ++used_;
+        }
+
+        T* object = ::new (slot->storage) T(std::forward<Args>(args)...);
+        slot->alive = true;
+        ++live_;
+        return object;
+    }
+
+    // The object must come from this pool, and nothing may point to it anymore
+    void destroy(T* object)
+    {
+        // The storage is the first member, so the object and its slot share an address
+        Slot* slot = reinterpret_cast<Slot*>(object);
+        object->~T();
+        slot->alive = false;
+        free_slots_.push_back(slot);
+        --live_;
+    }
+
+    // Destroys all the objects, keeps the memory for the next ones
+    void clear()
+    {
+        for (size_t i = 0; i < used_; ++i)
+        {
+            Slot& slot = chunks_[i / kChunkSize][i % kChunkSize];
+            if (slot.alive)
+            {
+                std::launder(reinterpret_cast<T*>(slot.storage))->~T();
+                slot.alive = false;
+            }
+        }
+
+        used_ = 0;
+        live_ = 0;
+        free_slots_.clear();
+    }
+
+    size_t size() const { return live_; }
+    size_t capacity() const { return chunks_.size() * kChunkSize; }
+
+private:
+    static constexpr size_t kChunkSize = 64;
+
+    struct Slot
+    {
+        alignas(T) std::byte storage[sizeof(T)];
+        bool alive = false;
+    };
+
+    std::vector<std::unique_ptr<Slot[]>> chunks_;
+    std::vector<Slot*> free_slots_;
+    size_t used_ = 0; // Slots handed out from the chunks so far, free ones included
+    size_t live_ = 0;
+};
@@ -3,30 +3,48 @@
 #include <fstream>
 #include <iostream>
 #include <optional>
+#include <ostream>
+#include <string>
+#include <string_view>
 
 #include "ActionRequest.h"
 #include "tank.h"
 
+// Writes the rounds through a reusable buffer, in large chunks instead of a flushed line per round.
+// The file is flushed at the end of the game, and every output_flush_rounds rounds when that's not 0.
 class OutputLogger
 {
 public:
     OutputLogger() = default;
     OutputLogger(const std::string& filename, const size_t total_tanks);
+    ~OutputLogger();
 
     OutputLogger(const OutputLogger&) = delete;
     OutputLogger& operator=(const OutputLogger&) = delete;
 
-    OutputLogger(OutputLogger&&) = default;
-    OutputLogger& operator=(OutputLogger&&) = default;
+    OutputLogger(OutputLogger&& other) noexcept;
+    OutputLogger& operator=(OutputLogger&& other) noexcept;
 
     bool is_valid() const;
 
-    void logAction(size_t tank_no, std::optional<ActionRequest> action, bool valid, bool was_alive_at_start, bool died_this_round);
+    void logAction(size_t tank_no, std::optional<ActionRequest> action, bool valid, bool was_alive_at_start, bool died_this_round,
+                   bool timed_out);
     void logResult(std::string&& result);
-    std::string action_to_string(ActionRequest action) const;
+
+    // The text of a tank's action in a round line, shared with the replay reader so both write the same file
+    static void writeAction(std::string& out, std::optional<ActionRequest> action, bool valid, bool was_alive_at_start, bool died_this_round,
+                            bool timed_out);
+    static std::string_view action_to_string(ActionRequest action);
 
 private:
+    static constexpr size_t kBufferSize = 64 * 1024;
+
+    void writeBuffer(bool flush);
+
     std::ofstream out_;
+    std::string buffer_;
     size_t total_tanks_ = 0;
+    size_t flush_rounds_ = 0; // 0 = only at the end of the game
+    size_t rounds_since_flush_ = 0;
     bool valid_ = false;
 };
@@ -0,0 +1,117 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "global_config.h"
+
+
+// The parts of a round the game manager times
+enum class GamePhase : size_t
+{
+    GetActions,     // All the algorithms choosing their actions
+    ExecuteActions, // Checking and executing the actions on the board
+    BoardUpdate,
+    ShellsStep,
+    Logging,
+    Count
+};
+
+std::string_view gamePhaseName(GamePhase phase);
+
+// Durations in power of two buckets of nanoseconds, bucket i holds [2^i, 2^(i+1)), and 0 goes to bucket 0
+class TimingHistogram
+{
+public:
+    static constexpr size_t kBuckets = 64;
+
+    void add(uint64_t ns);
+    void merge(const TimingHistogram& other);
+
+    uint64_t count() const { return count_; }
+    uint64_t totalNs() const { return total_ns_; }
+    uint64_t minNs() const { return count_ == 0 ? 0 : min_ns_; }
+    uint64_t maxNs() const { return max_ns_; }
+    const std::array<uint64_t, kBuckets>& buckets() const { return buckets_; }
+
+private:
+    std::array<uint64_t, kBuckets> buckets_{};
+    uint64_t count_ = 0;
+    uint64_t total_ns_ = 0;
+    uint64_t min_ns_ = UINT64_MAX;
+    uint64_t max_ns_ = 0;
+};
+
+// Where a game's time goes: a histogram per round phase, and per tank of the time its algorithm takes to choose an action.
+// Compiled in with profile_phases, the game manager then writes it next to the output file, as profile_format (json or csv).
+// Otherwise time() and timeAlgorithm() are plain calls and the clock is never read.
+class PhaseProfiler
+{
+public:
+    static constexpr bool kEnabled = config::get<bool>("profile_phases");
+
+    // (player id, tank id) of each tank, in play order
+    void setTanks(std::vector<std::pair<int, int>> tanks);
+
+    template <typename Fn>
+    void time(GamePhase phase, Fn&& fn)
+    {
+        if constexpr (kEnabled)
+        {
+            auto start = Clock::now();
+            fn();
+            record(phase, elapsedNs(start));
+        }
+        else
+        {
+            fn();
+        }
+    }
+
+    template <typename Fn>
+    void timeAlgorithm(size_t tank_no, Fn&& fn)
+    {
+        if constexpr (kEnabled)
+        {
+            auto start = Clock::now();
+            fn();
+            recordAlgorithm(tank_no, elapsedNs(start));
+        }
+        else
+        {
+            fn();
+        }
+    }
+
+    void record(GamePhase phase, uint64_t ns);
+    void recordAlgorithm(size_t tank_no, uint64_t ns); // Different tanks may record at the same time
+
+    const TimingHistogram& phase(GamePhase phase) const { return phases_[static_cast<size_t>(phase)]; }
+    const TimingHistogram& algorithm(size_t tank_no) const { return algorithms_[tank_no]; }
+
+    void writeJson(std::ostream& out) const;
+    void writeCsv(std::ostream& out) const;
+    bool writeToFile(const std::string& filename) const;
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    static uint64_t elapsedNs(Clock::time_point start)
+    {
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start).count());
+    }
+
+    // The algorithms' histograms merged per player, by player id
+    std::vector<std::pair<int, TimingHistogram>> playerHistograms() const;
+
+    std::array<TimingHistogram, static_cast<size_t>(GamePhase::Count)> phases_;
+    std::vector<TimingHistogram> algorithms_;
+    std::vector<std::pair<int, int>> tanks_;
+};
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <iostream>
+#include <memory>
 #include <unordered_map>
 #include <unordered_set>
 #include <vector>
@@ -8,7 +9,9 @@
 #include "Player.h"
 #include "SatelliteView.h"
 #include "TankAlgorithm.h"
-#include "cell.h"
+#include "grid.h"
+#include "satellite_snapshot.h"
+#include "shell_directions.h"
 #include "smart_battle_info.h"
 
 
@@ -29,21 +32,10 @@ public:
     virtual void updateTankWithBattleInfo(TankAlgorithm& tank, SatelliteView& satellite_view) override = 0;
 
 protected:
-    void setShellsAsNew(const std::vector<std::vector<Cell>>& grid);
+    void setShellsAsNew(const Grid& grid);
 
-    void updateShellPossibleDirections(const std::vector<std::vector<Cell>>& prev_grid,
-                                       const std::vector<std::vector<Cell>>& curr_grid);
-
-    void getShellPossibleDirectionsForTurnsPassed(const std::vector<std::vector<Cell>>& prev_grid,
-                                                  const std::vector<std::vector<Cell>>& curr_grid,
-                                                  const std::unordered_map<Position, std::unordered_set<Direction>>& prev_shell_possible_directions,
-                                                  size_t turns_passed,
-                                                  std::unordered_map<Position, std::unordered_set<Direction>>& candidate_map,
-                                                  std::vector<Position>& unexplainable_shells);
-
-    void accumulateDirections(std::unordered_map<Position, std::unordered_set<Direction>>& accumulated_directions,
-                              std::unordered_map<Position, std::unordered_set<Direction>>& candidate_map,
-                              const std::vector<Position>& unexplainable_shells);
+    void updateShellPossibleDirections(const SatelliteSnapshot& prev_snapshot, const Grid& curr_grid);
+    void computeShellDirectionMasks(const SatelliteSnapshot& prev_snapshot, const Grid& curr_grid, size_t interval);
 
     SmartBattleInfo createBattleInfo(const SatelliteView& satellite_view);
 
@@ -51,8 +43,16 @@ protected:
     size_t width_, height_;
     size_t max_steps_;
     size_t num_shells_;
-    std::vector<std::vector<Cell>> grid_; // Updates every time a tank asks for battle info
-    std::unordered_map<Position, std::unordered_set<Direction>> shell_possible_directions_;
-    // shell_possible_directions_[pos] = set of possible directions for shell at pos
+    std::shared_ptr<SatelliteSnapshot> snapshot_; // The view of the last battle info, shared with the tank it was sent to
+    std::shared_ptr<SatelliteSnapshot> prev_snapshot_; // The view of the battle info before, its buffer is reused for the next one
+    Grid grid_; // Refreshed in place every time a tank asks for battle info
+    std::vector<size_t> changed_cells_; // Scratch for refreshing grid_
+    ShellDirections shell_possible_directions_; // Possible directions for every shell on the board
     std::unordered_set<size_t> possible_turns_passed_; // Set of possible turns passed since the last GetBattleInfo request
+
+    // Scratch for updateShellPossibleDirections, kept between battle infos to reuse the memory
+    std::vector<Position> shells_;             // Shells in the current grid
+    std::vector<DirectionSet> turns_masks_;    // Per (turns passed, shell), empty = unexplainable
+    std::vector<size_t> unexplainable_counts_; // Per turns passed
+    std::vector<DirectionSet> prev_masks_;     // Per cell of the previous snapshot
 };
\ No newline at end of file
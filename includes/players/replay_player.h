@@ -0,0 +1,26 @@
+#pragma once
+
+#include "Player.h"
+#include "SatelliteView.h"
+#include "TankAlgorithm.h"
+
+
+// Player of a re-simulated game, its tanks replay recorded actions so battle info requests are left unanswered
+class ReplayPlayer : public Player
+{
+public:
+    ReplayPlayer(int player_index, size_t x, size_t y, size_t max_steps, size_t num_shells)
+        : Player(player_index, x, y, max_steps, num_shells) {}
+    virtual ~ReplayPlayer() override = default;
+
+    ReplayPlayer(const ReplayPlayer&) = delete;
+    ReplayPlayer& operator=(const ReplayPlayer&) = delete;
+    ReplayPlayer(ReplayPlayer&&) = delete;
+    ReplayPlayer& operator=(ReplayPlayer&&) = delete;
+
+    virtual void updateTankWithBattleInfo(TankAlgorithm& tank, SatelliteView& satellite_view) override
+    {
+        (void)tank;
+        (void)satellite_view;
+    }
+};
@@ -18,7 +18,7 @@ public:
         {
             for (size_t x = 0; x < width(); ++x)
             {
-                const Cell& cell = grid()[x][y];
+                const Cell& cell = grid().at(x, y);
                 std::string to_print = "[";
 
                 // Walls
@@ -35,7 +35,7 @@ public:
                     const auto& tanks = cell.getObjectsByType(ObjectType::Tank);
                     if (!tanks.empty())
                     {
-                        auto tank = std::static_pointer_cast<Tank>(tanks.front()); // Printing just one tank, couldn't be more
+                        auto tank = static_cast<const Tank*>(tanks.front()); // Printing just one tank, couldn't be more
                         to_print += std::to_string(tank->playerId());
                         to_print += directionToArrow(tank->direction());
                     }
@@ -47,7 +47,7 @@ public:
                     const auto& shells = cell.getObjectsByType(ObjectType::Shell);
                     if (!shells.empty())
                     {
-                        auto shell = std::static_pointer_cast<Shell>(shells.front()); // Printing just one shell, couldn't be more
+                        auto shell = static_cast<const Shell*>(shells.front()); // Printing just one shell, couldn't be more
                         to_print += "*";
                         to_print += directionToArrow(shell->direction());
                     }
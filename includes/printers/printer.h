@@ -1,34 +1,33 @@
 #pragma once
 
-#include "board.h"
-#include "cell.h"
+#include "grid.h"
 
 template <typename Derived>
 class Printer
 {
 public:
-    explicit Printer(const std::vector<std::vector<Cell>>& grid) : grid_(grid) {}
+    explicit Printer(const Grid& grid) : grid_(grid) {}
 
     void print() const
     {
         static_cast<const Derived*>(this)->printImpl();
     }
 
-    const std::vector<std::vector<Cell>>& grid() const
+    const Grid& grid() const
     {
         return grid_;
     }
 
     size_t width() const
     {
-        return grid_[0].size();
+        return grid_.width();
     }
 
     size_t height() const
     {
-        return grid_.size();
+        return grid_.height();
     }
 
 protected:
-    const std::vector<std::vector<Cell>>& grid_;
+    const Grid& grid_;
 };
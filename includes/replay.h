@@ -0,0 +1,123 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <optional>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "ActionRequest.h"
+#include "grid.h"
+
+
+// Binary record of a game, a compact alternative to the text output file it can reproduce.
+// All the numbers are little-endian.
+//   header: "TNKR", u8 version, u64 board hash, u32 width, height, max steps, num shells, max steps after tie,
+//           u32 tanks count, then u8 player id and u32 tank id per tank, in play order (a u8 tank id in version 1)
+//   rounds: one byte per tank per round, see ReplayAction
+//   result: kEndOfRounds, u32 length, the result line
+struct ReplayHeader
+{
+    uint64_t board_hash = 0;
+    uint32_t width = 0;
+    uint32_t height = 0;
+    uint32_t max_steps = 0;
+    uint32_t num_shells = 0;
+    uint32_t max_steps_after_tie = 0;
+    std::vector<std::pair<uint8_t, uint32_t>> tanks; // (player id, tank id) in play order
+};
+
+// A tank's round, packed in a byte, the action in the low 4 bits and the flags above it
+struct ReplayAction
+{
+    std::optional<ActionRequest> action;
+    bool valid = false;
+    bool alive_at_start = false;
+    bool killed = false; // Died this round
+    bool timed_out = false; // The algorithm ran out of time, the action is DoNothing
+
+    uint8_t pack() const;
+    static ReplayAction unpack(uint8_t byte);
+
+    static constexpr uint8_t kNoAction = 0x0F;
+    static constexpr uint8_t kValidBit = 0x10;
+    static constexpr uint8_t kAliveBit = 0x20;
+    static constexpr uint8_t kKilledBit = 0x40;
+    static constexpr uint8_t kTimedOutBit = 0x80;
+    static constexpr uint8_t kEndOfRounds = 0xFF; // Never a packed action, the top bit is only set with DoNothing
+};
+
+// Streams a replay to a file through a fixed-size buffer, so logging an action is a byte store
+class ReplayWriter
+{
+public:
+    ReplayWriter() = default;
+    ReplayWriter(const std::string& filename, const ReplayHeader& header);
+    ~ReplayWriter();
+
+    ReplayWriter(const ReplayWriter&) = delete;
+    ReplayWriter& operator=(const ReplayWriter&) = delete;
+
+    ReplayWriter(ReplayWriter&&) = default;
+    ReplayWriter& operator=(ReplayWriter&&) = default;
+
+    bool is_valid() const { return valid_; }
+
+    void logAction(std::optional<ActionRequest> action, bool valid, bool was_alive_at_start, bool died_this_round, bool timed_out);
+    void logResult(std::string_view result);
+
+    // Identifies the board a replay was recorded on, from its initial layout
+    static uint64_t hashBoard(const Grid& grid);
+
+private:
+    static constexpr size_t kBufferSize = 64 * 1024;
+
+    void put(uint8_t byte);
+    void putU32(uint32_t value);
+    void putU64(uint64_t value);
+    void flush();
+
+    std::ofstream out_;
+    std::vector<uint8_t> buffer_;
+    bool valid_ = false;
+};
+
+// Loads a whole recorded game, for re-simulating it or turning it back into the text output.
+// Reads binary replays, and text output files as well, which carry everything but the header.
+class ReplayReader
+{
+public:
+    explicit ReplayReader(const std::string& filename);
+
+    ReplayReader(const ReplayReader&) = delete;
+    ReplayReader& operator=(const ReplayReader&) = delete;
+    ReplayReader(ReplayReader&&) = default;
+    ReplayReader& operator=(ReplayReader&&) = default;
+
+    bool is_valid() const { return valid_; }
+
+    bool hasHeader() const { return has_header_; }          // A binary replay, a text output file has none
+    const ReplayHeader& header() const { return header_; } // Only the tanks count is known for a text output file
+    size_t tanks() const { return tanks_count_; }
+    size_t rounds() const { return tanks_count_ == 0 ? 0 : actions_.size() / tanks_count_; }
+    ReplayAction action(size_t round, size_t tank_no) const { return ReplayAction::unpack(actions_[round * tanks_count_ + tank_no]); }
+    const std::string& result() const { return result_; }
+
+    // Writes the text output file the game wrote when it was recorded
+    void writeText(std::ostream& out) const;
+
+private:
+    bool parse(const std::vector<uint8_t>& data);
+    bool parseText(const std::vector<uint8_t>& data);
+
+    ReplayHeader header_;
+    size_t tanks_count_ = 0;
+    std::vector<uint8_t> actions_; // Packed, round after round
+    std::string result_;
+    bool has_header_ = false;
+    bool valid_ = false;
+};
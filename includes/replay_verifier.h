@@ -0,0 +1,11 @@
+#pragma once
+
+#include <string>
+
+#include "replay.h"
+
+
+// Plays a board again from a recording of it, without running any tank algorithm.
+// Returns an empty string if the game matches its recording, otherwise the first thing that differs:
+// a recording of a different board, the first round a tank's action or its fate diverges, or the result.
+std::string verifyReplay(const std::string& board_file, const ReplayReader& recording);
@@ -0,0 +1,45 @@
+#pragma once
+
+#include <cstddef>
+#include <span>
+#include <vector>
+
+#include "position.h"
+
+// Row-major image of the board as seen by the satellite, one char per cell,
+// using the SatelliteView encoding ('#', '@', '*', ' ', or the player id of a tank).
+class SatelliteSnapshot
+{
+public:
+    SatelliteSnapshot() = default;
+    SatelliteSnapshot(size_t width, size_t height, char fill = ' ')
+        : width_(width), height_(height), chars_(width * height, fill) {}
+
+    size_t width() const { return width_; }
+    size_t height() const { return height_; }
+
+    // Keeps the buffer when the size is the same, the contents are left to be overwritten
+    void resize(size_t width, size_t height)
+    {
+        width_ = width;
+        height_ = height;
+        chars_.resize(width * height);
+    }
+
+    char at(size_t x, size_t y) const { return chars_[y * width_ + x]; }
+    char& at(size_t x, size_t y) { return chars_[y * width_ + x]; }
+
+    char operator[](const Position& pos) const { return at(pos.first, pos.second); }
+    char& operator[](const Position& pos) { return at(pos.first, pos.second); }
+
+    std::span<const char> row(size_t y) const { return {chars_.data() + y * width_, width_}; }
+    std::span<char> row(size_t y) { return {chars_.data() + y * width_, width_}; }
+
+    const char* data() const { return chars_.data(); }
+    char* data() { return chars_.data(); }
+
+private:
+    size_t width_ = 0;
+    size_t height_ = 0;
+    std::vector<char> chars_;
+};
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <cstddef>
+
 #include "movable_object.h"
 #include "types/direction.h"
 
@@ -9,6 +11,12 @@ class Shell : public MovableObject
 public:
     using MovableObject::MovableObject;
 
+    // Index of the shell in the board's active shells slot array
+    std::size_t slot() const { return slot_; }
+    void setSlot(std::size_t slot) { slot_ = slot; }
+
 private:
     virtual ObjectType type() const override;
+
+    std::size_t slot_ = 0;
 };
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+#include "direction.h"
+#include "position.h"
+
+// The directions each shell on the board may be flying in, one flat entry per shell, sorted by position
+class ShellDirections
+{
+public:
+    struct Entry
+    {
+        Position position;
+        DirectionSet directions;
+
+        bool operator==(const Entry& other) const = default;
+    };
+
+    void clear() { entries_.clear(); }
+    size_t size() const { return entries_.size(); }
+    bool empty() const { return entries_.empty(); }
+
+    // Shells are usually added in position order, which only appends
+    void set(const Position& pos, DirectionSet directions)
+    {
+        if (entries_.empty() || entries_.back().position < pos)
+        {
+            entries_.push_back({pos, directions});
+            return;
+        }
+
+        auto it = std::lower_bound(entries_.begin(), entries_.end(), pos, positionLess);
+        if (it != entries_.end() && it->position == pos)
+            it->directions = directions;
+        else
+            entries_.insert(it, {pos, directions});
+    }
+
+    // Null if nothing is known about a shell at the position
+    const DirectionSet* find(const Position& pos) const
+    {
+        auto it = std::lower_bound(entries_.begin(), entries_.end(), pos, positionLess);
+        return (it != entries_.end() && it->position == pos) ? &it->directions : nullptr;
+    }
+
+    std::vector<Entry>::const_iterator begin() const { return entries_.begin(); }
+    std::vector<Entry>::const_iterator end() const { return entries_.end(); }
+
+    bool operator==(const ShellDirections& other) const = default;
+
+private:
+    static bool positionLess(const Entry& entry, const Position& pos) { return entry.position < pos; }
+
+    std::vector<Entry> entries_;
+};
@@ -1,24 +1,27 @@
 #pragma once
 
 #include <iostream>
+#include <memory>
 #include <unordered_map>
 #include <unordered_set>
 
 #include "BattleInfo.h"
-#include "SatelliteView.h"
 #include "cell.h"
+#include "satellite_snapshot.h"
+#include "shell_directions.h"
 
 
+// The satellite image is captured once by the player and shared read-only with the tank it is sent to
 class SmartBattleInfo : public BattleInfo
 {
 public:
     ~SmartBattleInfo() = default;
-    SmartBattleInfo(const SatelliteView& satellite_view, size_t height, size_t width,
+    SmartBattleInfo(std::shared_ptr<const SatelliteSnapshot> snapshot, size_t height, size_t width,
                     size_t max_steps, size_t num_shells,
-                    const std::unordered_map<Position, std::unordered_set<Direction>>& shell_possible_directions = {},
+                    const ShellDirections& shell_possible_directions = {},
                     const std::unordered_map<int, std::unordered_set<Position>>& tanks_reserved_positions = {},
                     const std::unordered_map<Position, size_t>& walls_damage = {})
-        : satellite_view_(satellite_view), height_(height), width_(width),
+        : snapshot_(std::move(snapshot)), height_(height), width_(width),
           max_steps_(max_steps), num_shells_(num_shells),
           shell_possible_drections_(shell_possible_directions),
           tanks_reserved_positions_(tanks_reserved_positions),
@@ -29,12 +32,12 @@ public:
     SmartBattleInfo(SmartBattleInfo&&) = delete;
     SmartBattleInfo& operator=(SmartBattleInfo&&) = delete;
 
-    const SatelliteView& getSatelliteView() const { return satellite_view_; }
+    const SatelliteSnapshot& getSnapshot() const { return *snapshot_; } // '%' marks the tank the info is for
     size_t getHeight() const { return height_; }
     size_t getWidth() const { return width_; }
     size_t getMaxSteps() const { return max_steps_; }
     size_t getNumShells() const { return num_shells_; }
-    const std::unordered_map<Position, std::unordered_set<Direction>>& getShellPossibleDirections() const { return shell_possible_drections_; }
+    const ShellDirections& getShellPossibleDirections() const { return shell_possible_drections_; }
     const std::unordered_map<int, std::unordered_set<Position>>& getTanksReservedPositions() const { return tanks_reserved_positions_; }
     const std::unordered_map<Position, size_t>& getWallsDamage() const { return walls_damage_; }
 
@@ -61,12 +64,12 @@ public:
     }
 
 private:
-    const SatelliteView& satellite_view_;
+    std::shared_ptr<const SatelliteSnapshot> snapshot_;
     size_t height_;
     size_t width_;
     size_t max_steps_;
     size_t num_shells_;
-    std::unordered_map<Position, std::unordered_set<Direction>> shell_possible_drections_;
+    ShellDirections shell_possible_drections_;
     std::unordered_map<int, std::unordered_set<Position>> tanks_reserved_positions_;
     std::unordered_map<Position, size_t> walls_damage_; // Wall's position -> number of hits it has taken
 };
\ No newline at end of file
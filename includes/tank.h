@@ -28,6 +28,7 @@ public:
     bool canShoot() const;
     void shoot();
     bool isBacking() const;
+    size_t backwait() const { return backwait_; }
     void startBackwait();
     void tickBackwait();
     void resetBackwait();
@@ -35,6 +36,22 @@ public:
     bool waitingBackMove() const;
     void setWaitingBackMove(bool waiting_back_move);
     void copyRuntimeStateFrom(const Tank& other);
+
+    // Everything about the tank that changes during a game
+    struct RuntimeState
+    {
+        Position position;
+        Direction direction;
+        size_t shells;
+        size_t cooldown;
+        size_t backwait;
+        bool alive;
+        bool waiting_back_move;
+        ActionRequest last_action;
+    };
+    RuntimeState runtimeState() const;
+    void restoreRuntimeState(const RuntimeState& state);
+
     ActionRequest lastAction() const;
     void setLastAction(ActionRequest action);
 
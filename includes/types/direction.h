@@ -1,5 +1,11 @@
 #pragma once
 
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <iterator>
+
 enum class Direction
 {
     U = 0,
@@ -10,4 +16,86 @@ enum class Direction
     DL = 5,
     L = 6,
     UL = 7
-};
\ No newline at end of file
+};
+
+// Set of directions as a bit per direction, iterated in Direction order
+class DirectionSet
+{
+public:
+    class Iterator
+    {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = Direction;
+        using difference_type = std::ptrdiff_t;
+        using pointer = void;
+        using reference = Direction;
+
+        constexpr Iterator() = default;
+        constexpr explicit Iterator(uint8_t remaining) : remaining_(remaining) {}
+
+        constexpr Direction operator*() const { return static_cast<Direction>(std::countr_zero(remaining_)); }
+        constexpr Iterator& operator++()
+        {
+            remaining_ &= remaining_ - 1; // Drop the lowest direction
+            return *this;
+        }
+        constexpr Iterator operator++(int)
+        {
+            Iterator previous = *this;
+            ++*this;
+            return previous;
+        }
+        constexpr bool operator==(const Iterator& other) const = default;
+
+    private:
+        uint8_t remaining_ = 0;
+    };
+
+    constexpr DirectionSet() = default;
+    constexpr DirectionSet(std::initializer_list<Direction> directions)
+    {
+        for (Direction dir : directions)
+        {
+            insert(dir);
+        }
+    }
+
+    static constexpr DirectionSet all() { return fromBits(0xFF); }
+    static constexpr DirectionSet fromBits(uint8_t bits)
+    {
+        DirectionSet set;
+        set.bits_ = bits;
+        return set;
+    }
+
+    constexpr uint8_t bits() const { return bits_; }
+    constexpr bool contains(Direction dir) const { return bits_ & bit(dir); }
+    constexpr size_t size() const { return std::popcount(bits_); }
+    constexpr bool empty() const { return bits_ == 0; }
+
+    constexpr void insert(Direction dir) { bits_ |= bit(dir); }
+    constexpr void erase(Direction dir) { bits_ &= ~bit(dir); }
+
+    constexpr DirectionSet& operator|=(DirectionSet other)
+    {
+        bits_ |= other.bits_;
+        return *this;
+    }
+    constexpr DirectionSet& operator&=(DirectionSet other)
+    {
+        bits_ &= other.bits_;
+        return *this;
+    }
+    friend constexpr DirectionSet operator|(DirectionSet lhs, DirectionSet rhs) { return lhs |= rhs; }
+    friend constexpr DirectionSet operator&(DirectionSet lhs, DirectionSet rhs) { return lhs &= rhs; }
+    constexpr bool operator==(const DirectionSet& other) const = default;
+
+    constexpr Iterator begin() const { return Iterator(bits_); }
+    constexpr Iterator end() const { return Iterator(0); }
+
+private:
+    static constexpr uint8_t bit(Direction dir) { return static_cast<uint8_t>(1u << static_cast<size_t>(dir)); }
+
+    uint8_t bits_ = 0;
+};
@@ -10,6 +10,8 @@ class Wall : public GameObjectInterface
 public:
     void weaken();
     bool isDestroyed() const;
+    std::size_t hitCount() const { return hit_count; }
+    void setHitCount(std::size_t count) { hit_count = count; }
 
 private:
     virtual ObjectType type() const override;
@@ -0,0 +1,34 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "cell.h"
+#include "game_object_interface.h"
+#include "tank.h"
+
+
+// Zobrist hashing of a board state, the hash is the xor of a key per (cell, object) and a key per tank's runtime state.
+// Keys are derived from what they describe with splitmix64 rather than drawn into tables, so they need no sizing
+// per board and are the same in every build and run, which lets hashes be compared across builds.
+namespace zobrist
+{
+
+constexpr uint64_t mix(uint64_t value)
+{
+    value += 0x9E3779B97F4A7C15ull;
+    value = (value ^ (value >> 30)) * 0xBF58476D1CE4E5B9ull;
+    value = (value ^ (value >> 27)) * 0x94D049BB133111EBull;
+    return value ^ (value >> 31);
+}
+
+// A tank is keyed by its owner, id and direction, a shell by its direction, a wall by the hits it took
+uint64_t objectKey(size_t cell_index, const GameObjectInterface& object);
+
+// All the objects of the cell
+uint64_t cellKey(size_t cell_index, const Cell& cell);
+
+// Whatever of a tank isn't on the board, its ammo, cooldown and backward move state
+uint64_t tankStateKey(const Tank& tank);
+
+} // namespace zobrist
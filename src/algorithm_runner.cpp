@@ -0,0 +1,257 @@
+#include "algorithm_runner.h"
+
+#include <algorithm>
+#include <exception>
+
+#include "dropped_action_listener.h"
+
+
+AlgorithmRunner::AlgorithmRunner(size_t tanks_count, std::chrono::nanoseconds action_budget, std::chrono::nanoseconds game_budget,
+                                 size_t threads, PhaseProfiler* profiler)
+    : action_budget_(action_budget), game_budget_(game_budget), threads_(threads), tanks_(tanks_count), profiler_(profiler)
+{
+    if (threads_ > 1 && !enforced())
+    {
+        pool_ = std::make_unique<ThreadPool>(threads);
+    }
+}
+
+TimedAction AlgorithmRunner::getAction(size_t tank_no, TankAlgorithm& algorithm)
+{
+    if (!enforced())
+    {
+        return {callInPlace(tank_no, algorithm), false};
+    }
+
+    std::optional<BudgetedCall> budgeted_call = startCall(tank_no, algorithm);
+    return budgeted_call ? finishCall(tank_no, std::move(*budgeted_call)) : timedOut();
+}
+
+void AlgorithmRunner::getActions(const std::vector<TankAlgorithm*>& algorithms, std::vector<TimedAction>& r_actions)
+{
+    r_actions.assign(algorithms.size(), TimedAction{});
+
+    if (pool_)
+    {
+        std::vector<std::future<ActionRequest>> calls(algorithms.size());
+        for (size_t i = 0; i < algorithms.size(); ++i)
+        {
+            if (algorithms[i])
+            {
+                calls[i] = pool_->submit([this, i, algorithm = algorithms[i]]
+                                         { return callInPlace(i, *algorithm); });
+            }
+        }
+
+        // Every call is waited for before an exception is passed on, none is left running into the next phase
+        std::exception_ptr exception;
+        for (size_t i = 0; i < calls.size(); ++i)
+        {
+            if (!calls[i].valid())
+            {
+                continue;
+            }
+            try
+            {
+                r_actions[i].action = calls[i].get();
+            }
+            catch (...)
+            {
+                if (!exception)
+                    exception = std::current_exception();
+            }
+        }
+        if (exception)
+        {
+            std::rethrow_exception(exception);
+        }
+        return;
+    }
+
+    if (threads_ <= 1)
+    {
+        for (size_t i = 0; i < algorithms.size(); ++i)
+        {
+            if (algorithms[i])
+                r_actions[i] = getAction(i, *algorithms[i]);
+        }
+        return;
+    }
+
+    // Up to threads_ calls run at once, each one waited for in tank order frees its worker for the next call to start,
+    // so the deadlines of the calls running together run together
+    round_calls_.clear();
+    round_calls_.resize(algorithms.size());
+    size_t next_call = 0;
+    size_t running = 0;
+
+    std::exception_ptr exception;
+    for (size_t i = 0; i < algorithms.size(); ++i)
+    {
+        for (; next_call < algorithms.size() && running < threads_; ++next_call)
+        {
+            if (algorithms[next_call])
+            {
+                round_calls_[next_call] = startCall(next_call, *algorithms[next_call]);
+                running += round_calls_[next_call].has_value();
+            }
+        }
+
+        if (!algorithms[i])
+        {
+            continue;
+        }
+        try
+        {
+            if (round_calls_[i])
+            {
+                --running; // Returned or left late on its own worker, either way it no longer takes one of ours
+                r_actions[i] = finishCall(i, std::move(*round_calls_[i]));
+            }
+            else
+            {
+                r_actions[i] = timedOut();
+            }
+        }
+        catch (...)
+        {
+            if (!exception)
+                exception = std::current_exception();
+        }
+    }
+    if (exception)
+    {
+        std::rethrow_exception(exception);
+    }
+}
+
+ActionRequest AlgorithmRunner::callInPlace(size_t tank_no, TankAlgorithm& algorithm)
+{
+    if (!profiler_)
+    {
+        return algorithm.getAction();
+    }
+
+    ActionRequest action = ActionRequest::DoNothing;
+    profiler_->timeAlgorithm(tank_no, [&]
+                             { action = algorithm.getAction(); });
+    return action;
+}
+
+std::optional<AlgorithmRunner::BudgetedCall> AlgorithmRunner::startCall(size_t tank_no, TankAlgorithm& algorithm)
+{
+    TankState& state = tanks_[tank_no];
+    if (!settleLateCall(tank_no))
+    {
+        return std::nullopt;
+    }
+
+    auto budget = std::chrono::nanoseconds::max();
+    if (action_budget_.count() > 0)
+    {
+        budget = action_budget_;
+    }
+    if (game_budget_.count() > 0)
+    {
+        budget = std::min(budget, game_budget_ - state.used);
+    }
+    if (budget.count() <= 0)
+    {
+        return std::nullopt;
+    }
+
+    BudgetedCall budgeted_call;
+    budgeted_call.algorithm = &algorithm;
+    budgeted_call.worker = takeWorker();
+    budgeted_call.budget = budget;
+    budgeted_call.deadline = std::chrono::steady_clock::now() + budget;
+    budgeted_call.call = budgeted_call.worker->submit([&algorithm]
+                                                      {
+                                                          auto start = std::chrono::steady_clock::now();
+                                                          ActionRequest action = algorithm.getAction();
+                                                          auto elapsed = std::chrono::steady_clock::now() - start;
+                                                          return std::make_pair(action, std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed));
+                                                      });
+    return budgeted_call;
+}
+
+TimedAction AlgorithmRunner::finishCall(size_t tank_no, BudgetedCall&& budgeted_call)
+{
+    TankState& state = tanks_[tank_no];
+    if (budgeted_call.call.wait_until(budgeted_call.deadline) == std::future_status::ready)
+    {
+        idle_workers_.push_back(std::move(budgeted_call.worker));
+        auto [action, elapsed] = budgeted_call.call.get(); // Rethrows what the algorithm has thrown
+        state.used += elapsed;
+        recordTime(tank_no, elapsed);
+        return {action, false};
+    }
+
+    // The worker stays with the call, the algorithm isn't asked again before it returns
+    state.used += budgeted_call.budget;
+    state.late_call = std::move(budgeted_call.call);
+    state.late_algorithm = budgeted_call.algorithm;
+    state.late_charged = budgeted_call.budget;
+    state.late_worker = std::move(budgeted_call.worker);
+    return timedOut();
+}
+
+TimedAction AlgorithmRunner::timedOut()
+{
+    ++timeouts_;
+    return {ActionRequest::DoNothing, true};
+}
+
+bool AlgorithmRunner::settleLateCall(size_t tank_no)
+{
+    TankState& state = tanks_[tank_no];
+    if (!state.late_call.valid())
+    {
+        return true;
+    }
+    if (state.late_call.wait_for(std::chrono::nanoseconds::zero()) != std::future_status::ready)
+    {
+        return false;
+    }
+
+    // Too late for its round, only its time counts, and an exception it has thrown is dropped with its action
+    try
+    {
+        auto elapsed = state.late_call.get().second;
+        state.used += std::max(elapsed - state.late_charged, std::chrono::nanoseconds::zero());
+        recordTime(tank_no, elapsed);
+    }
+    catch (...)
+    {
+        // Charged up to its deadline only
+    }
+    idle_workers_.push_back(std::move(state.late_worker));
+
+    if (auto* listener = dynamic_cast<DroppedActionListener*>(state.late_algorithm))
+    {
+        listener->actionDropped();
+    }
+    state.late_algorithm = nullptr;
+    return true;
+}
+
+std::unique_ptr<ThreadPool> AlgorithmRunner::takeWorker()
+{
+    if (idle_workers_.empty())
+    {
+        return std::make_unique<ThreadPool>(1);
+    }
+
+    std::unique_ptr<ThreadPool> worker = std::move(idle_workers_.back());
+    idle_workers_.pop_back();
+    return worker;
+}
+
+void AlgorithmRunner::recordTime(size_t tank_no, std::chrono::nanoseconds elapsed)
+{
+    if constexpr (PhaseProfiler::kEnabled)
+    {
+        if (profiler_)
+            profiler_->recordAlgorithm(tank_no, static_cast<uint64_t>(elapsed.count()));
+    }
+}
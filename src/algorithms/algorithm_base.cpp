@@ -1,5 +1,7 @@
 #include "algorithms/algorithm_base.h"
 
+#include <utility>
+
 #include "algorithms/algorithm_utils.h"
 #include "global_config.h"
 #include "printers/ansi_printer.h"
@@ -11,6 +13,11 @@ AlgorithmBase::AlgorithmBase(int player_index, int tank_index) : player_index_(p
 
 bool AlgorithmBase::hasLineOfSightToOpponent(const Position& start, Direction dir, Position& r_opponent_pos) const
 {
+    if (rays_.built())
+    {
+        return hasLineOfSightFromRays(start, dir, r_opponent_pos);
+    }
+
     Position current = forwardPosition(start, dir, width_, height_);
 
     for (size_t steps = 0; steps < std::max(width_, height_); ++steps)
@@ -20,7 +27,7 @@ bool AlgorithmBase::hasLineOfSightToOpponent(const Position& start, Direction di
             return false; // We are back to the starting position
         }
 
-        const Cell& cell = grid_[current.first][current.second];
+        const Cell& cell = grid_[current];
 
         if (cell.has(ObjectType::Wall))
         {
@@ -28,7 +35,7 @@ bool AlgorithmBase::hasLineOfSightToOpponent(const Position& start, Direction di
         }
         else if (cell.has(ObjectType::Tank))
         {
-            auto tank = std::static_pointer_cast<Tank>(cell.getObjectByType(ObjectType::Tank));
+            const auto* tank = static_cast<const Tank*>(cell.getObjectByType(ObjectType::Tank));
             if (tank->playerId() != player_index_)
             {
                 r_opponent_pos = current;
@@ -56,18 +63,22 @@ bool AlgorithmBase::isShellIncoming(const Position& pos,
                                     Direction* r_shell_possible_dir,
                                     size_t shell_max_distance) const
 {
-    std::vector<Direction> directions_to_check = {Direction::U, Direction::UR, Direction::R, Direction::DR,
-                                                  Direction::D, Direction::DL, Direction::L, Direction::UL};
+    if (rays_.built())
+    {
+        return isShellIncomingFromRays(pos, r_shell_pos, r_shell_possible_dir, shell_max_distance);
+    }
+
+    DirectionSet directions_to_check = DirectionSet::all(); // In Direction order, U first
 
     // Check up to `shell_max_distance` steps
     for (size_t steps = 1; steps <= shell_max_distance; ++steps)
     {
-        std::vector<Direction> next_to_check;
+        DirectionSet next_to_check;
         // Check all directions
-        for (const auto& dir : directions_to_check)
+        for (Direction dir : directions_to_check)
         {
             Position current = backwardPosition(pos, dir, width_, height_, steps);
-            const Cell& cell = grid_[current.first][current.second];
+            const Cell& cell = grid_[current];
 
             if (cell.has(ObjectType::Wall))
             {
@@ -78,8 +89,8 @@ bool AlgorithmBase::isShellIncoming(const Position& pos,
             // If we made it through, the shell has a line of sight to us
             if (cell.has(ObjectType::Shell))
             {
-                auto possible_directions = shell_possible_directions_.find(current);
-                if (possible_directions == shell_possible_directions_.end() || possible_directions->second.count(dir))
+                const DirectionSet* possible_directions = shell_possible_directions_.find(current);
+                if (!possible_directions || possible_directions->contains(dir))
                 {
                     // If we have possible directions for this shell, check if the current direction
                     // is one of them. If not (shouldn't happen), assume the shell is incoming
@@ -96,16 +107,86 @@ bool AlgorithmBase::isShellIncoming(const Position& pos,
             }
 
             // Continue scanning in this direction
-            next_to_check.push_back(dir);
+            next_to_check.insert(dir);
         }
 
         // Update directions for the next distance layer
-        directions_to_check = std::move(next_to_check);
+        directions_to_check = next_to_check;
     }
 
     return false; // No incoming shell found
 }
 
+// Same as hasLineOfSightToOpponent, answered from the ray table
+bool AlgorithmBase::hasLineOfSightFromRays(const Position& start, Direction dir, Position& r_opponent_pos) const
+{
+    // We only look as far as max(width, height) cells
+    uint32_t distance = rays_.blockerDistance(grid_.index(start), dir);
+    if (distance == RayTable::no_hit || distance > std::max(width_, height_))
+    {
+        return false; // No opponent found
+    }
+
+    Position blocker = forwardPosition(start, dir, width_, height_, distance);
+    if (blocker == start)
+    {
+        return false; // We are back to the starting position
+    }
+
+    const Cell& cell = grid_[blocker];
+
+    if (cell.has(ObjectType::Wall))
+    {
+        return false; // Wall in the way
+    }
+
+    const auto* tank = static_cast<const Tank*>(cell.getObjectByType(ObjectType::Tank));
+    if (tank->playerId() != player_index_)
+    {
+        r_opponent_pos = blocker;
+        return true; // Found an opponent
+    }
+
+    return false; // Don't shoot our own tanks
+}
+
+// Same as isShellIncoming, answered from the ray table
+bool AlgorithmBase::isShellIncomingFromRays(const Position& pos,
+                                            Position* r_shell_pos,
+                                            Direction* r_shell_possible_dir,
+                                            size_t shell_max_distance) const
+{
+    size_t index = grid_.index(pos);
+
+    // Take the closest shell, and among equally close shells the first direction in U to UL order
+    uint32_t closest = RayTable::no_hit;
+    Direction closest_dir = Direction::U;
+    for (const auto& dir : getAllDirections())
+    {
+        uint32_t distance = rays_.shellDistance(index, dir);
+        if (distance < closest)
+        {
+            closest = distance;
+            closest_dir = dir;
+        }
+    }
+
+    if (closest == RayTable::no_hit || closest > shell_max_distance)
+    {
+        return false; // No incoming shell found
+    }
+
+    if (r_shell_pos)
+    {
+        *r_shell_pos = backwardPosition(pos, closest_dir, width_, height_, closest); // Output the position of the incoming shell
+    }
+    if (r_shell_possible_dir)
+    {
+        *r_shell_possible_dir = closest_dir; // Output the possible dangerous direction of the shell
+    }
+    return true;
+}
+
 std::optional<ActionRequest> AlgorithmBase::getEvadeActionIfShellIncoming(size_t shell_max_distance) const
 {
     // Check if there's an incoming shell towards the tank's position
@@ -131,7 +212,7 @@ std::optional<ActionRequest> AlgorithmBase::getEvadeActionIfShellIncoming(size_t
             // We can just move forward and evade the shell
             // Before, we need to check if the next cell is safe
             Position next_pos = forwardPosition(tank_pos, tank_dir, width_, height_);
-            const Cell& next_cell = grid_[next_pos.first][next_pos.second];
+            const Cell& next_cell = grid_[next_pos];
 
             if (next_cell.empty() && !isShellIncoming(next_pos, nullptr, nullptr, shell_max_distance))
             {
@@ -156,7 +237,7 @@ std::optional<ActionRequest> AlgorithmBase::getEvadeActionIfShellIncoming(size_t
             if (new_dir != shell_possible_dir && new_dir != getOppositeDirection(shell_possible_dir))
             {
                 Position new_pos = forwardPosition(tank_pos, new_dir, width_, height_);
-                const Cell& new_cell = grid_[new_pos.first][new_pos.second];
+                const Cell& new_cell = grid_[new_pos];
 
                 // Check if the next position after rotation is safe
                 // curr_pos -> rotation -> MoveForward -> new_pos
@@ -175,8 +256,8 @@ std::optional<ActionRequest> AlgorithmBase::getEvadeActionIfShellIncoming(size_t
         }
 
         // If we reach here, we couldn't find a safe action to evade the shell
-        auto possible_directions = shell_possible_directions_.find(shell_pos);
-        if (possible_directions != shell_possible_directions_.end() && possible_directions->second.size() > 1)
+        const DirectionSet* possible_directions = shell_possible_directions_.find(shell_pos);
+        if (possible_directions && possible_directions->size() > 1)
         {
             // If we are not sure about the shell's direction, request for battle info to find it
             if constexpr (config::get<bool>("verbose_debug"))
@@ -212,24 +293,83 @@ void AlgorithmBase::updateBattleInfo(BattleInfo& info)
     width_ = concrete_info.getWidth();
     size_t num_shells = concrete_info.getNumShells();
 
+    // Our tank's cell is always rebuilt, so keep its runtime state for the new tank object
+    std::optional<Tank::RuntimeState> tank_state;
+    if (tank_)
+    {
+        tank_state = tank_->runtimeState();
+    }
+
     Position tank_pos;
-    const SatelliteView& satellite_view = concrete_info.getSatelliteView();
-    grid_ = reconstructGridFromSatelliteView(satellite_view, height_, width_, player_index_, num_shells, tank_pos);
-    shell_possible_directions_ = concrete_info.getShellPossibleDirections();
+    refreshed_cells_.clear();
+    bool refreshed = refreshGridFromSnapshot(grid_, concrete_info.getSnapshot(), player_index_, num_shells, tank_pos, refreshed_cells_);
+    tank_ = static_cast<Tank*>(grid_[tank_pos].getObjectByType(ObjectType::Tank));
+    if (tank_state)
+    {
+        tank_->restoreRuntimeState(*tank_state);
+    }
 
-    auto tank_obj = grid_[tank_pos.first][tank_pos.second].getObjectByType(ObjectType::Tank);
-    auto new_tank = std::static_pointer_cast<Tank>(tank_obj);
+    ShellDirections previous_shell_directions = std::move(shell_possible_directions_);
+    shell_possible_directions_ = concrete_info.getShellPossibleDirections();
+    for (size_t index : refreshed_cells_)
+    {
+        markCellChanged(index);
+    }
 
-    // If we already have a tank, transfer all runtime state to the new tank object
-    if (tank_)
+    if (!refreshed)
     {
-        new_tank->copyRuntimeStateFrom(*tank_);
+        all_cells_changed_ = true;
+        rays_.invalidate(); // Built again when a search needs it
+    }
+    else if (rays_.built())
+    {
+        rays_.updateCells(grid_, shell_possible_directions_, refreshed_cells_);
+
+        // A shell whose possible directions changed threatens other cells, even where the grid didn't change
+        for (const ShellDirections* shells : {&previous_shell_directions, &shell_possible_directions_})
+        {
+            for (const auto& [pos, directions] : *shells)
+            {
+                rays_.updateCell(grid_, shell_possible_directions_, grid_.index(pos));
+            }
+        }
     }
-    tank_ = new_tank;
 
     extendBattleInfoProcessing(concrete_info);
 }
 
+void AlgorithmBase::clearChangedCells()
+{
+    changed_cells_.clear();
+    all_cells_changed_ = false;
+}
+
+void AlgorithmBase::markCellChanged(size_t index)
+{
+    if (all_cells_changed_)
+        return;
+
+    if (changed_cells_.size() >= grid_.size() / 8)
+    {
+        all_cells_changed_ = true;
+        changed_cells_.clear();
+        return;
+    }
+
+    changed_cells_.push_back(index);
+}
+
+void AlgorithmBase::prepareRays()
+{
+    // Every tank keeps its own table, past ray_table_max_mb the memory of a game with many tanks costs more than
+    // the walks it saves
+    static const size_t max_cells = (config::get<size_t>("ray_table_max_mb") << 20) / RayTable::bytesPerCell();
+    if (!rays_.built() && grid_.size() <= max_cells)
+    {
+        rays_.rebuild(grid_, shell_possible_directions_);
+    }
+}
+
 void AlgorithmBase::handleTankMovement(const ActionRequest action)
 {
     tank_->decreaseCooldown();
@@ -241,12 +381,20 @@ void AlgorithmBase::handleTankMovement(const ActionRequest action)
         Position current_pos = tank_->position();
         Position new_pos = forwardPosition(current_pos, tank_->direction(), width_, height_);
 
-        Cell& current_cell = grid_[current_pos.first][current_pos.second];
-        Cell& new_cell = grid_[new_pos.first][new_pos.second];
+        Cell& current_cell = grid_[current_pos];
+        Cell& new_cell = grid_[new_pos];
 
         new_cell.addObject(tank_);
         current_cell.removeObject(tank_);
         tank_->position() = new_pos;
+        markCellChanged(grid_.index(current_pos));
+        markCellChanged(grid_.index(new_pos));
+
+        if (rays_.built())
+        {
+            rays_.updateCell(grid_, shell_possible_directions_, grid_.index(current_pos));
+            rays_.updateCell(grid_, shell_possible_directions_, grid_.index(new_pos));
+        }
         break;
     }
     case ActionRequest::RotateLeft90:
@@ -321,6 +469,12 @@ ActionRequest AlgorithmBase::getAction()
         printTankInfo();
     }
 
+    pre_action_turns_till_battle_info_ = turns_till_next_battle_info_;
+    if (tank_)
+    {
+        pre_action_state_ = tank_->runtimeState();
+    }
+
     if (turns_till_next_battle_info_ == 0)
     {
         // We want no more than battle_info_interval turns between GetBattleInfo requests
@@ -346,3 +500,34 @@ ActionRequest AlgorithmBase::getAction()
     handleTankMovement(action);
     return action;
 }
+
+void AlgorithmBase::actionDropped()
+{
+    turns_till_next_battle_info_ = pre_action_turns_till_battle_info_ == 0 ? 0 : pre_action_turns_till_battle_info_ - 1;
+    if (!tank_)
+    {
+        return;
+    }
+
+    Position current_pos = tank_->position();
+    Position previous_pos = pre_action_state_.position;
+    if (current_pos != previous_pos)
+    {
+        grid_[previous_pos].addObject(tank_);
+        grid_[current_pos].removeObject(tank_);
+        markCellChanged(grid_.index(current_pos));
+        markCellChanged(grid_.index(previous_pos));
+
+        if (rays_.built())
+        {
+            rays_.updateCell(grid_, shell_possible_directions_, grid_.index(current_pos));
+            rays_.updateCell(grid_, shell_possible_directions_, grid_.index(previous_pos));
+        }
+    }
+
+    extendDroppedActionHandling();
+
+    // The tank did nothing in the action's place, which still counts down its cooldown
+    tank_->restoreRuntimeState(pre_action_state_);
+    tank_->decreaseCooldown();
+}
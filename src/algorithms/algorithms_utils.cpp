@@ -1,11 +1,15 @@
 #include "algorithms/algorithm_utils.h"
 
+#include <array>
+
+#include "board_satellite_view.h"
+#include "bulk_satellite_view.h"
 #include "global_config.h"
 #include "printers/ansi_printer.h"
 #include "printers/default_printer.h"
 
 
-void printGrid(const std::vector<std::vector<Cell>>& grid)
+void printGrid(const Grid& grid)
 {
     using SelectedPrinter = std::conditional_t<config::get<bool>("use_ansi_printer"), AnsiPrinter, DefaultPrinter>;
     SelectedPrinter printer(grid);
@@ -121,12 +125,12 @@ std::string directionToArrow(Direction dir)
 
 Position forwardPosition(const Position& pos, Direction dir, size_t width, size_t height, size_t steps)
 {
-    static const std::unordered_map<Direction, std::pair<int, int>> deltas = {
-        {Direction::U, {0, -1}}, {Direction::UR, {1, -1}}, {Direction::R, {1, 0}}, {Direction::DR, {1, 1}},
-        {Direction::D, {0, 1}}, {Direction::DL, {-1, 1}}, {Direction::L, {-1, 0}}, {Direction::UL, {-1, -1}}
-    };
+    // Indexed by Direction, U through UL clockwise
+    static constexpr std::array<std::pair<int, int>, 8> deltas = {{
+        {0, -1}, {1, -1}, {1, 0}, {1, 1}, {0, 1}, {-1, 1}, {-1, 0}, {-1, -1}
+    }};
 
-    auto [dx, dy] = deltas.at(dir);
+    auto [dx, dy] = deltas[static_cast<size_t>(dir)];
     int new_x = (pos.first + (dx + width) * steps) % width;
     int new_y = (pos.second + (dy + height) * steps) % height;
 
@@ -157,37 +161,34 @@ Direction getSeedDirection(int player_index)
     return (player_index % 2 == 1) ? Direction::L : Direction::R;
 }
 
-size_t getNumberOfShellsInGrid(const std::vector<std::vector<Cell>>& grid)
+size_t getNumberOfShellsInGrid(const Grid& grid)
 {
     size_t count = 0;
-    for (const auto& row : grid)
+    for (const auto& cell : grid)
     {
-        for (const auto& cell : row)
+        if (cell.has(ObjectType::Shell))
         {
-            if (cell.has(ObjectType::Shell))
-            {
-                ++count;
-            }
+            ++count;
         }
     }
     return count;
 }
 
 // Moving *backward* from a position in a given direction, checking if there are walls blocking the path
-bool isBlockedByWall(const std::vector<std::vector<Cell>>& grid, const Position& from, Direction dir, size_t steps)
+bool isBlockedByWall(const SatelliteSnapshot& snapshot, const Position& from, Direction dir, size_t steps)
 {
-    if (grid.empty() || grid[0].empty())
+    if (snapshot.width() == 0)
     {
-        return true; // If grid is empty, assume walls are blocking
+        return true; // If there's no snapshot, assume walls are blocking
     }
 
-    size_t height = grid.size();
-    size_t width = grid[0].size();
+    size_t height = snapshot.height();
+    size_t width = snapshot.width();
     Position pos = from;
     for (size_t i = 0; i < steps; ++i)
     {
         pos = backwardPosition(pos, dir, width, height);
-        if (grid[pos.first][pos.second].has(ObjectType::Wall))
+        if (snapshot[pos] == '#')
         {
             return true;
         }
@@ -204,55 +205,115 @@ const std::vector<Direction>& getAllDirections()
     return all_directions;
 }
 
-std::vector<std::vector<Cell>> reconstructGridFromSatelliteView(const SatelliteView& satellite_view, size_t height,
-                                                                size_t width, int player_index, size_t num_shells,
-                                                                Position& r_tank_pos)
+void captureSatelliteView(const SatelliteView& satellite_view, size_t width, size_t height, SatelliteSnapshot& r_snapshot)
 {
-    std::vector<std::vector<Cell>> grid(height, std::vector<Cell>(width));
+    r_snapshot.resize(width, height);
+
+    // One copy of the whole image when the view offers it, a virtual call per cell otherwise
+    if (const auto* bulk_view = dynamic_cast<const BulkSatelliteView*>(&satellite_view))
+    {
+        bulk_view->copyTo(std::span<char>(r_snapshot.data(), width * height), width, height);
+        return;
+    }
 
     for (size_t y = 0; y < height; ++y)
     {
+        auto row = r_snapshot.row(y);
         for (size_t x = 0; x < width; ++x)
         {
-            char ch = satellite_view.getObjectAt(x, y);
-            Position pos{x, y};
-            Cell cell(pos);
-
-            switch (ch)
-            {
-            case '#':
-                cell.addObject(std::make_shared<Wall>());
-                break;
-            case '@':
-                cell.addObject(std::make_shared<Mine>());
-                break;
-            case '*':
-                cell.addObject(std::make_shared<Shell>(Direction::U)); // Direction is unreliable
-                break;
-            case '1':
-            case '2':
-            case '3':
-            case '4':
-            case '5':
-            case '6':
-            case '7':
-            case '8':
-            case '9':
-                cell.addObject(std::make_shared<Tank>(ch - '0', 0, pos, getSeedDirection(ch - '0'),
-                                                      num_shells)); // Direction is unreliable unless it's first turn
-                break;
-            case '%':
-                cell.addObject(std::make_shared<Tank>(player_index, 0, pos, getSeedDirection(player_index),
-                                                      num_shells)); // Direction is unreliable unless it's first turn
-                r_tank_pos = pos;
-                break;
-            default:
-                break;
-            }
-
-            grid[x][y] = std::move(cell);
+            row[x] = satellite_view.getObjectAt(x, y);
         }
     }
+}
 
-    return grid;
-}
\ No newline at end of file
+// Puts in a cell the object its snapshot character shows, as the only object there
+static void placeFromSnapshot(Grid& r_grid, const Position& pos, char ch, int player_index, size_t num_shells,
+                              Position& r_tank_pos)
+{
+    switch (ch)
+    {
+    case '#':
+        r_grid.emplace<Wall>(pos);
+        break;
+    case '@':
+        r_grid.emplace<Mine>(pos);
+        break;
+    case '*':
+        r_grid.emplace<Shell>(pos, Direction::U); // Direction is unreliable
+        break;
+    case '1':
+    case '2':
+    case '3':
+    case '4':
+    case '5':
+    case '6':
+    case '7':
+    case '8':
+    case '9':
+        r_grid.emplace<Tank>(pos, ch - '0', 0, pos, getSeedDirection(ch - '0'),
+                           num_shells); // Direction is unreliable unless it's first turn
+        break;
+    case '%':
+        r_grid.emplace<Tank>(pos, player_index, 0, pos, getSeedDirection(player_index),
+                           num_shells); // Direction is unreliable unless it's first turn
+        r_tank_pos = pos;
+        break;
+    default:
+        break;
+    }
+}
+
+// Empties a cell, destroying its objects
+static void releaseCellObjects(Grid& r_grid, Cell& r_cell)
+{
+    for (auto* object : r_cell.getObjectsByType(ObjectType::Tank))
+        r_grid.release(static_cast<Tank*>(object));
+    for (auto* object : r_cell.getObjectsByType(ObjectType::Shell))
+        r_grid.release(static_cast<Shell*>(object));
+    for (auto* object : r_cell.getObjectsByType(ObjectType::Mine))
+        r_grid.release(static_cast<Mine*>(object));
+    for (auto* object : r_cell.getObjectsByType(ObjectType::Wall))
+        r_grid.release(static_cast<Wall*>(object));
+    r_cell.clear();
+}
+
+void reconstructGridFromSnapshot(Grid& r_grid, const SatelliteSnapshot& snapshot, int player_index, size_t num_shells,
+                                 Position& r_tank_pos)
+{
+    r_grid.reset(snapshot.width(), snapshot.height());
+
+    for (size_t y = 0; y < snapshot.height(); ++y)
+    {
+        auto row = snapshot.row(y);
+        for (size_t x = 0; x < row.size(); ++x)
+        {
+            if (row[x] != ' ') // Most of the board
+                placeFromSnapshot(r_grid, Position(x, y), row[x], player_index, num_shells, r_tank_pos);
+        }
+    }
+}
+
+bool refreshGridFromSnapshot(Grid& r_grid, const SatelliteSnapshot& snapshot, int player_index, size_t num_shells,
+                             Position& r_tank_pos, std::vector<size_t>& r_changed_cells)
+{
+    if (r_grid.width() != snapshot.width() || r_grid.height() != snapshot.height())
+    {
+        reconstructGridFromSnapshot(r_grid, snapshot, player_index, num_shells, r_tank_pos);
+        return false;
+    }
+
+    // A reconstructed cell holds at most one object, whose character the snapshot shows. Anything else was
+    // changed since, by the snapshot or by the grid's owner, and the character is never '%'.
+    const char* chars = snapshot.data();
+    for (size_t i = 0; i < r_grid.size(); ++i)
+    {
+        Cell& cell = r_grid.cell(i);
+        if (chars[i] == BoardSatelliteView::cellToChar(cell) && cell.getObjectsCount() <= 1)
+            continue;
+
+        releaseCellObjects(r_grid, cell);
+        placeFromSnapshot(r_grid, r_grid.position(i), chars[i], player_index, num_shells, r_tank_pos);
+        r_changed_cells.push_back(i);
+    }
+    return true;
+}
@@ -0,0 +1,76 @@
+#include "algorithms/bfs_state.h"
+
+#include <algorithm>
+
+
+WallsDamageSets::WallsDamageSets()
+{
+    clear();
+}
+
+void WallsDamageSets::clear()
+{
+    sets_.assign(1, DamageSet{}); // Id 0 is the empty set
+    total_hits_.assign(1, 0);
+    ids_.clear();
+    ids_.emplace(DamageSet{}, 0);
+    transitions_.clear();
+}
+
+size_t WallsDamageSets::hits(uint32_t id, uint32_t wall_index) const
+{
+    for (const auto& [index, wall_hits] : sets_[id])
+    {
+        if (index == wall_index)
+        {
+            return wall_hits;
+        }
+    }
+    return 0;
+}
+
+uint32_t WallsDamageSets::withHit(uint32_t id, uint32_t wall_index)
+{
+    uint64_t transition = (static_cast<uint64_t>(id) << 32) | wall_index;
+    if (auto it = transitions_.find(transition); it != transitions_.end())
+    {
+        return it->second;
+    }
+
+    DamageSet next = sets_[id];
+    auto wall_it = std::lower_bound(next.begin(), next.end(), std::make_pair(wall_index, uint8_t{0}));
+    if (wall_it != next.end() && wall_it->first == wall_index)
+    {
+        ++wall_it->second;
+    }
+    else
+    {
+        next.insert(wall_it, {wall_index, uint8_t{1}});
+    }
+
+    auto [set_it, inserted] = ids_.emplace(next, static_cast<uint32_t>(sets_.size()));
+    if (inserted)
+    {
+        sets_.push_back(std::move(next));
+        total_hits_.push_back(total_hits_[id] + 1);
+    }
+
+    transitions_.emplace(transition, set_it->second);
+    return set_it->second;
+}
+
+void SparseBits::reset(size_t size)
+{
+    if (bits_.size() != size)
+    {
+        bits_.assign(size, false);
+        set_indices_.clear();
+        return;
+    }
+
+    for (size_t index : set_indices_)
+    {
+        bits_[index] = false;
+    }
+    set_indices_.clear();
+}
@@ -0,0 +1,221 @@
+#include "algorithms/ray_table.h"
+
+#include <utility>
+
+#include "algorithms/algorithm_utils.h"
+
+
+// Indexed by Direction, as forwardPosition steps
+static constexpr std::array<std::pair<int, int>, 8> kDeltas = {{
+    {0, -1}, {1, -1}, {1, 0}, {1, 1}, {0, 1}, {-1, 1}, {-1, 0}, {-1, -1}
+}};
+
+// One step on the wrapping board, without the divisions of forwardPosition
+static void advance(size_t& r_x, size_t& r_y, int dx, int dy, size_t width, size_t height)
+{
+    if (dx > 0)
+        r_x = r_x + 1 == width ? 0 : r_x + 1;
+    else if (dx < 0)
+        r_x = r_x == 0 ? width - 1 : r_x - 1;
+
+    if (dy > 0)
+        r_y = r_y + 1 == height ? 0 : r_y + 1;
+    else if (dy < 0)
+        r_y = r_y == 0 ? height - 1 : r_y - 1;
+}
+
+void RayTable::rebuild(const Grid& grid, const ShellDirections& shell_possible_directions)
+{
+    width_ = grid.width();
+    height_ = grid.height();
+    size_ = grid.size();
+
+    // Most cells are empty and Pass in every plane
+    cells_.assign(size_, CellState{});
+    for (size_t i = 0; i < size_; ++i)
+    {
+        if (!grid.cell(i).empty())
+            cells_[i] = cellState(grid, shell_possible_directions, i);
+    }
+
+    for (size_t p = 0; p < planes_.size(); ++p)
+    {
+        buildPlane(p);
+    }
+
+    built_ = true;
+}
+
+void RayTable::updateCell(const Grid& grid, const ShellDirections& shell_possible_directions, size_t index)
+{
+    CellState before = cells_[index];
+    cells_[index] = cellState(grid, shell_possible_directions, index);
+
+    for (size_t p = 0; p < planes_.size(); ++p)
+    {
+        if (rayCell(p, before) != rayCell(p, cells_[index]))
+            updatePlane(p, index);
+    }
+}
+
+void RayTable::updateCells(const Grid& grid, const ShellDirections& shell_possible_directions, std::span<const size_t> indices)
+{
+    // Every changed cell walks back along its rays, past a few percent of the board one pass over it is cheaper
+    static constexpr size_t rebuild_share = 64;
+
+    if (indices.size() * rebuild_share > size_)
+    {
+        rebuild(grid, shell_possible_directions);
+        return;
+    }
+
+    for (size_t index : indices)
+    {
+        updateCell(grid, shell_possible_directions, index);
+    }
+}
+
+RayTable::CellState RayTable::cellState(const Grid& grid, const ShellDirections& shell_possible_directions, size_t index)
+{
+    const Cell& cell = grid.cell(index);
+    CellState state;
+
+    // Mines and shells don't block line of sight, a wall also protects us from shells behind it
+    if (cell.has(ObjectType::Wall))
+        state.flags = kBlocker | kWall;
+    else if (cell.has(ObjectType::Tank))
+        state.flags = kBlocker;
+
+    if (cell.has(ObjectType::Shell))
+    {
+        // A shell we know nothing about may be flying any way
+        const DirectionSet* possible_directions = shell_possible_directions.find(grid.position(index));
+        state.shell_directions = possible_directions ? *possible_directions : DirectionSet::all();
+    }
+
+    return state;
+}
+
+RayTable::RayCell RayTable::rayCell(size_t plane, const CellState& state)
+{
+    if (plane < 8)
+        return (state.flags & kBlocker) ? RayCell::Hit : RayCell::Pass;
+
+    if (state.flags & kWall)
+        return RayCell::Stop;
+
+    // A shell is only a threat if it may be flying our way
+    return state.shell_directions.contains(static_cast<Direction>(plane - 8)) ? RayCell::Hit : RayCell::Pass;
+}
+
+Direction RayTable::step(size_t plane)
+{
+    Direction dir = static_cast<Direction>(plane % 8);
+    return plane < 8 ? dir : getOppositeDirection(dir);
+}
+
+size_t RayTable::next(size_t plane, size_t index) const
+{
+    Position pos = forwardPosition(Position(index % width_, index / width_), step(plane), width_, height_);
+    return pos.second * width_ + pos.first;
+}
+
+size_t RayTable::previous(size_t plane, size_t index) const
+{
+    Position pos = backwardPosition(Position(index % width_, index / width_), step(plane), width_, height_);
+    return pos.second * width_ + pos.first;
+}
+
+// The distance of the cell behind `ahead`, from what `ahead` holds and its own distance
+RayTable::Distance RayTable::distanceFrom(size_t plane, size_t ahead) const
+{
+    switch (rayCell(plane, cells_[ahead]))
+    {
+    case RayCell::Hit:
+        return 1;
+    case RayCell::Stop:
+        return kFar;
+    case RayCell::Pass:
+        break;
+    }
+    return stepBehind(planes_[plane][ahead]);
+}
+
+// Stepping in a direction on a wrapping board is a permutation of the cells, so every ray is a cycle
+void RayTable::buildPlane(size_t plane)
+{
+    auto& distances = planes_[plane];
+    distances.assign(size_, kFar);
+    visited_.assign(size_, false);
+
+    auto [dx, dy] = kDeltas[static_cast<size_t>(step(plane))];
+    for (size_t start = 0; start < size_; ++start)
+    {
+        if (visited_[start])
+            continue;
+
+        // Walk the cycle once to mark it, and find some cell that is not Pass, with none the whole ray keeps kFar
+        size_t terminal = size_;
+        size_t x = start % width_;
+        size_t y = start / width_;
+        size_t index = start;
+        do
+        {
+            visited_[index] = true;
+            if (terminal == size_ && rayCell(plane, cells_[index]) != RayCell::Pass)
+                terminal = index;
+
+            advance(x, y, dx, dy, width_, height_);
+            index = y * width_ + x;
+        } while (index != start);
+
+        if (terminal == size_)
+            continue;
+
+        // Walk the cycle backwards from the cell before the terminal, so each cell's next is already known
+        x = terminal % width_;
+        y = terminal / width_;
+        size_t ahead = terminal;
+        do
+        {
+            advance(x, y, -dx, -dy, width_, height_);
+            size_t at = y * width_ + x;
+            distances[at] = distanceFrom(plane, ahead);
+            ahead = at;
+        } while (ahead != terminal);
+    }
+}
+
+void RayTable::updatePlane(size_t plane, size_t index)
+{
+    auto& distances = planes_[plane];
+
+    // The cell's own distance only depends on it if its ray comes back to it with nothing on the way
+    Distance distance = kFar;
+    size_t current = index;
+    for (Distance steps = 1;; steps = stepBehind(steps))
+    {
+        current = next(plane, current);
+        RayCell cell = rayCell(plane, cells_[current]);
+        if (cell == RayCell::Hit)
+        {
+            distance = steps;
+            break;
+        }
+        if (cell == RayCell::Stop || current == index)
+            break;
+    }
+    distances[index] = distance;
+
+    // Cells behind it see it directly, up to and including the previous cell that is not Pass
+    current = index;
+    for (size_t behind = previous(plane, index); behind != index; behind = previous(plane, behind))
+    {
+        distances[behind] = distanceFrom(plane, current);
+
+        if (rayCell(plane, cells_[behind]) != RayCell::Pass)
+            break;
+
+        current = behind;
+    }
+}
@@ -1,6 +1,7 @@
 #include "algorithms/smart_algorithm.h"
 
 #include <algorithm>
+#include <array>
 #include <iostream>
 #include <optional>
 #include <queue>
@@ -46,9 +47,9 @@ void SmartAlgorithm::extendBattleInfoProcessing(SmartBattleInfo& info)
     }
 
     // Invalidate cached path if the opponent moved
-    const Cell& target_cell = grid_[cached_target_.first][cached_target_.second];
+    const Cell& target_cell = grid_[cached_target_];
     if (!target_cell.has(ObjectType::Tank) ||
-        static_pointer_cast<Tank>(target_cell.getObjectByType(ObjectType::Tank))->playerId() == player_index_)
+        static_cast<const Tank*>(target_cell.getObjectByType(ObjectType::Tank))->playerId() == player_index_)
     {
         if constexpr (config::get<bool>("verbose_debug"))
         {
@@ -193,7 +194,7 @@ void SmartAlgorithm::extendShootActionHandling()
 {
     // If we shoot a wall, we need to update the walls damage map
     Position next_pos = forwardPosition(tank_->position(), tank_->direction(), width_, height_);
-    const Cell& next_cell = grid_[next_pos.first][next_pos.second];
+    const Cell& next_cell = grid_[next_pos];
 
     if (next_cell.has(ObjectType::Wall))
     {
@@ -202,9 +203,86 @@ void SmartAlgorithm::extendShootActionHandling()
     }
 }
 
+void SmartAlgorithm::extendDroppedActionHandling()
+{
+    // The path went on without the dropped step
+    cached_path_ = {};
+
+    // Take back the wall hit of a dropped shot, only a hit counted since the last battle info is still ours to take back
+    if (tank_->ammo() == pre_action_state_.shells)
+    {
+        return;
+    }
+    Position next_pos = forwardPosition(tank_->position(), tank_->direction(), width_, height_);
+    auto local = local_walls_damage_.find(next_pos);
+    if (local == local_walls_damage_.end())
+    {
+        return;
+    }
+
+    if (--local->second == 0)
+    {
+        local_walls_damage_.erase(local);
+    }
+    auto total = total_walls_damage_.find(next_pos);
+    if (total != total_walls_damage_.end() && --total->second == 0)
+    {
+        total_walls_damage_.erase(total);
+    }
+}
+
+Position SmartAlgorithm::statePosition(const BFSState& state) const
+{
+    return grid_.position(state.pos_index);
+}
+
+size_t SmartAlgorithm::visitedBitIndex(const BFSState& state) const
+{
+    // Cooldown is in [0, 4], so each (pos, dir) owns 5 consecutive bits
+    return (static_cast<size_t>(state.pos_index) * 8 + static_cast<size_t>(state.dir)) * 5 + state.cooldown;
+}
+
+void SmartAlgorithm::resetSearch()
+{
+    static thread_local SearchScratch scratch;
+    search_ = &scratch;
+
+    search_->nodes.clear();
+    search_->visited_bits.assign((grid_.size() * 8 * 5 + 63) / 64, 0);
+    search_->visited_with_damage.clear();
+    search_->walls_damage_sets.clear();
+
+    previous_search_.valid = false;
+    previous_search_.cells_read.reset(grid_.size());
+    previous_search_.rays_read.reset(grid_.size() * 8);
+}
+
+void SmartAlgorithm::pushState(const BFSState& state, uint32_t parent, ActionRequest action)
+{
+    size_t bit = visitedBitIndex(state);
+
+    // Check if the state has already been visited, states with no walls damaged take the dense bitset
+    if (state.walls_damage_id == 0)
+    {
+        uint64_t mask = uint64_t{1} << (bit % 64);
+        if (search_->visited_bits[bit / 64] & mask)
+            return;
+
+        search_->visited_bits[bit / 64] |= mask;
+    }
+    else
+    {
+        uint64_t key = (static_cast<uint64_t>(state.walls_damage_id) << 32) | bit;
+        if (!search_->visited_with_damage.insert(key).second)
+            return;
+    }
+
+    search_->nodes.push_back({state, parent, action});
+}
+
 bool SmartAlgorithm::isCellEmptyInState(const BFSState& state, const Position& pos) const
 {
-    const Cell& cell = grid_[pos.first][pos.second];
+    const Cell& cell = grid_[pos];
 
     if (cell.empty())
     {
@@ -215,7 +293,7 @@ bool SmartAlgorithm::isCellEmptyInState(const BFSState& state, const Position& p
     {
         // Check if the wall has been damaged enough and destroyed
         size_t hits_before_search = getOrDefault(total_walls_damage_, pos, (size_t)0);
-        size_t hits_in_state = getOrDefault(state.walls_damage, pos, (size_t)0);
+        size_t hits_in_state = search_->walls_damage_sets.hits(state.walls_damage_id, grid_.index(pos));
 
         return (hits_before_search + hits_in_state) >= 2; // Wall is destroyed if it has been hitten twice
     }
@@ -223,10 +301,7 @@ bool SmartAlgorithm::isCellEmptyInState(const BFSState& state, const Position& p
     return false; // Cell is not empty
 }
 
-void SmartAlgorithm::tryRotations(std::queue<BFSState>& q,
-                                  std::unordered_map<BFSState, std::pair<BFSState, ActionRequest>>& parent,
-                                  std::unordered_set<BFSState>& visited,
-                                  const BFSState& current)
+void SmartAlgorithm::tryRotations(const BFSState& current, uint32_t current_index)
 {
     static constexpr std::array<ActionRequest, 4> rotations = {
         ActionRequest::RotateLeft90, ActionRequest::RotateLeft45,
@@ -234,120 +309,89 @@ void SmartAlgorithm::tryRotations(std::queue<BFSState>& q,
 
     for (ActionRequest action : rotations)
     {
-        Direction new_dir = getDirectionAfterRotation(current.dir, action);
         BFSState rotated_state = current;
-        rotated_state.dir = new_dir;
+        rotated_state.dir = getDirectionAfterRotation(current.dir, action);
 
         if (rotated_state.cooldown > 0)
             rotated_state.cooldown--;
 
-        // Check if the next state has already been visited
-        if (visited.find(rotated_state) == visited.end())
-        {
-            visited.insert(rotated_state);
-            parent[rotated_state] = {current, action};
-            q.push(rotated_state);
-        }
+        pushState(rotated_state, current_index, action);
     }
 }
 
-void SmartAlgorithm::tryForwardMove(std::queue<BFSState>& q,
-                                    std::unordered_map<BFSState, std::pair<BFSState, ActionRequest>>& parent,
-                                    std::unordered_set<BFSState>& visited,
-                                    const BFSState& current)
+void SmartAlgorithm::tryForwardMove(const BFSState& current, uint32_t current_index)
 {
-    Position next_pos = forwardPosition(current.pos, current.dir, width_, height_);
+    Position next_pos = forwardPosition(statePosition(current), current.dir, width_, height_);
+    previous_search_.cells_read.set(grid_.index(next_pos));
 
     // Check if the next cell is empty, not threatened by a shell, and not reserved by another tank
     if (isCellEmptyInState(current, next_pos) && !isShellIncoming(next_pos) &&
         !other_tanks_reserved_positions_.count(next_pos))
     {
         BFSState next_state = current;
-        next_state.pos = next_pos;
+        next_state.pos_index = static_cast<uint32_t>(grid_.index(next_pos));
 
         if (next_state.cooldown > 0)
             next_state.cooldown--;
 
-        // Check if the next state has already been visited
-        if (visited.find(next_state) == visited.end())
-        {
-            visited.insert(next_state);
-            parent[next_state] = {current, ActionRequest::MoveForward};
-            q.push(next_state);
-        }
+        pushState(next_state, current_index, ActionRequest::MoveForward);
     }
 }
 
-void SmartAlgorithm::tryGetBattleInfo(std::queue<BFSState>& q,
-                                      std::unordered_map<BFSState, std::pair<BFSState, ActionRequest>>& parent,
-                                      std::unordered_set<BFSState>& visited,
-                                      const BFSState& current)
+void SmartAlgorithm::tryGetBattleInfo(const BFSState& current, uint32_t current_index)
 {
     BFSState next_state = current;
 
     if (next_state.cooldown > 0)
         next_state.cooldown--;
 
-    // Check if the next state has already been visited
-    if (visited.find(next_state) == visited.end())
-    {
-        visited.insert(next_state);
-        parent[next_state] = {current, ActionRequest::GetBattleInfo};
-        q.push(next_state);
-    }
+    pushState(next_state, current_index, ActionRequest::GetBattleInfo);
 }
 
-void SmartAlgorithm::tryShootingAWall(std::queue<BFSState>& q,
-                                      std::unordered_map<BFSState, std::pair<BFSState, ActionRequest>>& parent,
-                                      std::unordered_set<BFSState>& visited,
-                                      const BFSState& current)
+void SmartAlgorithm::tryShootingAWall(const BFSState& current, uint32_t current_index)
 {
-    if (current.shells_left <= 1 || current.cooldown > 0)
+    // Shooting walls is the only way the search spends shells
+    size_t shells_left = search_start_ammo_ - search_->walls_damage_sets.totalHits(current.walls_damage_id);
+
+    if (shells_left <= 1 || current.cooldown > 0)
     {
         // Never shoot if we have only one shell left, as we need it to shoot the opponent.
         // Can't shoot if there's cooldown left.
         return;
     }
 
-    Position next_pos = forwardPosition(current.pos, current.dir, width_, height_);
-    const Cell& next_cell = grid_[next_pos.first][next_pos.second];
+    Position next_pos = forwardPosition(statePosition(current), current.dir, width_, height_);
+    const Cell& next_cell = grid_[next_pos];
+    previous_search_.cells_read.set(grid_.index(next_pos));
 
     // Check if the next cell is a wall and has not destroyed yet
     if (next_cell.has(ObjectType::Wall))
     {
+        uint32_t wall_index = static_cast<uint32_t>(grid_.index(next_pos));
         size_t hits_before_search = getOrDefault(total_walls_damage_, next_pos, (size_t)0);
-        size_t hits_in_state = getOrDefault(current.walls_damage, next_pos, (size_t)0);
+        size_t hits_in_state = search_->walls_damage_sets.hits(current.walls_damage_id, wall_index);
 
         if (hits_before_search + hits_in_state < 2)
         {
             // The wall has not been destroyed yet, we can try to shoot it
             BFSState next_state = current;
-            next_state.shells_left--;
             next_state.cooldown = 4;
-            next_state.walls_damage[next_pos] = hits_in_state + 1;
+            next_state.walls_damage_id = search_->walls_damage_sets.withHit(current.walls_damage_id, wall_index);
 
-            // Check if the next state has already been visited
-            if (visited.find(next_state) == visited.end())
-            {
-                visited.insert(next_state);
-                parent[next_state] = {current, ActionRequest::Shoot};
-                q.push(next_state);
-            }
+            pushState(next_state, current_index, ActionRequest::Shoot);
         }
     }
 }
 
-ActionRequest SmartAlgorithm::handleLineOfSightToOpponent(BFSState& current,
-                                                          std::unordered_map<BFSState, std::pair<BFSState, ActionRequest>>& parent,
-                                                          const BFSState& start_state,
-                                                          const Position& opponent_pos)
+ActionRequest SmartAlgorithm::handleLineOfSightToOpponent(uint32_t node_index, const Position& opponent_pos)
 {
     // Found line of sight to target, reconstruct the first move.
     if constexpr (config::get<bool>("verbose_debug"))
     {
         // For debugging purposes
-        std::cout << "[SmartAlgorithm] Found line of sight from Pos" << current.pos
-                  << " Dir=" << directionToString(current.dir)
+        const BFSState& state = search_->nodes[node_index].state;
+        std::cout << "[SmartAlgorithm] Found line of sight from Pos" << statePosition(state)
+                  << " Dir=" << directionToString(state.dir)
                   << " to target at " << opponent_pos << std::endl;
 
         std::cout << "[SmartAlgorithm] Backtracking to find first move to execute:" << std::endl;
@@ -356,24 +400,20 @@ ActionRequest SmartAlgorithm::handleLineOfSightToOpponent(BFSState& current,
     cached_target_ = opponent_pos;
     std::vector<ActionRequest> moves_reversed;
 
-    while (parent.find(current) != parent.end() && parent[current].first != start_state)
+    // The start node is the only node that is its own parent
+    while (search_->nodes[node_index].parent != node_index)
     {
-        moves_reversed.push_back(parent[current].second);
-        current = parent[current].first;
+        moves_reversed.push_back(search_->nodes[node_index].action);
+        node_index = search_->nodes[node_index].parent;
     }
 
-    moves_reversed.push_back(parent[current].second);
+    std::reverse(moves_reversed.begin(), moves_reversed.end());
 
     if constexpr (config::get<bool>("verbose_debug"))
     {
         std::cout << "[SmartAlgorithm] First move to execute: "
-                  << tankActionToString(parent[current].second) << std::endl;
-    }
-
-    std::reverse(moves_reversed.begin(), moves_reversed.end());
+                  << tankActionToString(moves_reversed.front()) << std::endl;
 
-    if constexpr (config::get<bool>("verbose_debug"))
-    {
         std::cout << "[SmartAlgorithm] Path to opponent: ";
         for (size_t i = 0; i < moves_reversed.size(); ++i)
         {
@@ -387,11 +427,177 @@ ActionRequest SmartAlgorithm::handleLineOfSightToOpponent(BFSState& current,
     // Store the found path in cached_path_
     cached_path_ = std::queue<ActionRequest>(std::deque<ActionRequest>(moves_reversed.begin(), moves_reversed.end()));
 
-    return parent[current].second;
+    return moves_reversed.front();
+}
+
+void SmartAlgorithm::recordSearch(const BFSState& start_state, std::optional<ActionRequest> result)
+{
+    previous_search_.valid = true;
+    previous_search_.start_state = start_state;
+    previous_search_.start_ammo = search_start_ammo_;
+    previous_search_.width = width_;
+    previous_search_.height = height_;
+
+    previous_search_.found = result.has_value();
+    previous_search_.path.clear();
+    if (result)
+    {
+        std::queue<ActionRequest> path_copy = cached_path_;
+        while (!path_copy.empty())
+        {
+            previous_search_.path.push_back(path_copy.front());
+            path_copy.pop();
+        }
+        previous_search_.target = cached_target_;
+    }
+
+    clearChangedCells(); // The grid changes are counted from this search on
+
+    previous_search_.walls_damage = total_walls_damage_;
+    previous_search_.reserved_positions = other_tanks_reserved_positions_;
+    previous_search_.shell_possible_directions = shell_possible_directions_;
+}
+
+bool SmartAlgorithm::isPreviousSearchAffectedBy(const Position& changed_pos) const
+{
+    // Shells are looked for this far back from a cell we enter, see tryForwardMove
+    static constexpr size_t shell_scan_distance = 8;
+
+    const auto& record = previous_search_;
+
+    // The search may have tried to enter or shoot the cell itself
+    if (record.cells_read[grid_.index(changed_pos)])
+        return true;
+
+    for (size_t d = 0; d < 8; ++d)
+    {
+        Direction dir = static_cast<Direction>(d);
+
+        // A shell appearing or leaving here changes whether the cells ahead of it are threatened
+        for (size_t steps = 1; steps <= shell_scan_distance; ++steps)
+        {
+            if (record.cells_read[grid_.index(forwardPosition(changed_pos, dir, width_, height_, steps))])
+                return true;
+        }
+
+        // Line of sight rays passing through here start behind it, up to the first wall or tank
+        for (size_t steps = 1; steps <= std::max(width_, height_); ++steps)
+        {
+            Position pos = backwardPosition(changed_pos, dir, width_, height_, steps);
+            if (pos == changed_pos)
+                break;
+
+            if (record.rays_read[grid_.index(pos) * 8 + d])
+                return true;
+
+            const Cell& cell = grid_[pos];
+            if (cell.has(ObjectType::Wall) || cell.has(ObjectType::Tank))
+                break; // Rays from further back stop here, unless this cell changed too and is checked on its own
+        }
+    }
+
+    return false;
+}
+
+// The search is a function of its start state and of what it read from the grid, so if the start state is the same
+// and none of what it read changed, it would find the same path again (or fail again).
+// Only the cells that changed since the search are looked at, so replanning doesn't walk the whole board.
+bool SmartAlgorithm::canReusePreviousSearch(const BFSState& start_state) const
+{
+    const auto& record = previous_search_;
+
+    if (!record.valid || record.width != width_ || record.height != height_ ||
+        record.start_state.pos_index != start_state.pos_index || record.start_state.dir != start_state.dir ||
+        record.start_state.cooldown != start_state.cooldown || record.start_ammo != tank_->ammo())
+    {
+        return false;
+    }
+
+    // Cells whose objects changed, when too many did it isn't worth checking them
+    if (allCellsChanged())
+        return false;
+
+    for (size_t index : changedCells())
+    {
+        if (isPreviousSearchAffectedBy(grid_.position(index)))
+            return false;
+    }
+
+    // Walls damage and reserved positions are only read for the cell the search tries to enter or shoot
+    auto damage_changed = [this, &record](const std::unordered_map<Position, size_t>& from,
+                                          const std::unordered_map<Position, size_t>& to)
+    {
+        for (const auto& [pos, damage] : from)
+        {
+            if (getOrDefault(to, pos, (size_t)0) != damage && record.cells_read[grid_.index(pos)])
+                return true;
+        }
+        return false;
+    };
+
+    if (damage_changed(total_walls_damage_, record.walls_damage) || damage_changed(record.walls_damage, total_walls_damage_))
+        return false;
+
+    auto reserved_changed = [this, &record](const std::unordered_set<Position>& from, const std::unordered_set<Position>& to)
+    {
+        for (const auto& pos : from)
+        {
+            if (!to.count(pos) && record.cells_read[grid_.index(pos)])
+                return true;
+        }
+        return false;
+    };
+
+    if (reserved_changed(other_tanks_reserved_positions_, record.reserved_positions) ||
+        reserved_changed(record.reserved_positions, other_tanks_reserved_positions_))
+        return false;
+
+    // Shells whose possible directions changed threaten different cells
+    auto shells_changed = [this](const ShellDirections& from, const ShellDirections& to)
+    {
+        for (const auto& [pos, directions] : from)
+        {
+            const DirectionSet* to_directions = to.find(pos);
+            if ((!to_directions || *to_directions != directions) && isPreviousSearchAffectedBy(pos))
+                return true;
+        }
+        return false;
+    };
+
+    return !shells_changed(shell_possible_directions_, record.shell_possible_directions) &&
+           !shells_changed(record.shell_possible_directions, shell_possible_directions_);
 }
 
-// Finds the shortest path to shoot the opponent using BFS, then breaks ties by choosing the path whose end is closest to the opponent.
 std::optional<ActionRequest> SmartAlgorithm::findFirstSafeActionToOpponent()
+{
+    search_start_ammo_ = tank_->ammo();
+
+    BFSState start_state{static_cast<uint32_t>(grid_.index(tank_->position())), 0, tank_->direction(),
+                         static_cast<uint8_t>(tank_->cooldown())};
+
+    if (canReusePreviousSearch(start_state))
+    {
+        if constexpr (config::get<bool>("verbose_debug"))
+        {
+            std::cout << "[SmartAlgorithm] Nothing the previous BFS read has changed, reusing its result" << std::endl;
+        }
+
+        if (!previous_search_.found)
+            return std::nullopt;
+
+        const auto& path = previous_search_.path;
+        cached_target_ = previous_search_.target;
+        cached_path_ = std::queue<ActionRequest>(std::deque<ActionRequest>(path.begin(), path.end()));
+        return path.front();
+    }
+
+    auto result = runSearch(start_state);
+    recordSearch(start_state, result);
+    return result;
+}
+
+// Finds the shortest path to shoot the opponent using BFS, then breaks ties by choosing the path whose end is closest to the opponent.
+std::optional<ActionRequest> SmartAlgorithm::runSearch(const BFSState& start_state)
 {
     if constexpr (config::get<bool>("verbose_debug"))
     {
@@ -399,67 +605,82 @@ std::optional<ActionRequest> SmartAlgorithm::findFirstSafeActionToOpponent()
         std::cout << "[SmartAlgorithm] Starting BFS toward opponent" << std::endl;
     }
 
-    std::queue<BFSState> q;
-    std::unordered_map<BFSState, std::pair<BFSState, ActionRequest>> parent;
-    std::unordered_set<BFSState> visited;
-
-    BFSState start_state{tank_->position(), tank_->direction(), tank_->ammo(), tank_->cooldown(), {}};
-    q.push(start_state);
-    visited.insert(start_state);
+    resetSearch();
+    prepareRays(); // Every state checks line of sight and every forward move checks for shells
+    pushState(start_state, 0, ActionRequest::DoNothing);
 
     bool found = false;
-    std::vector<std::pair<BFSState, Position>> candidates; // (state, opponent position)
+    std::vector<std::pair<uint32_t, Position>> candidates; // (node index, opponent position)
 
     size_t iterations = 0;
     size_t iterations_limit = config::get<size_t>("bfs_iterations_limit");
 
-    while (!q.empty() && !found)
+    // Nodes are appended in BFS order, so the queue is the range [layer_begin, search_->nodes.size())
+    size_t layer_begin = 0;
+
+    while (layer_begin < search_->nodes.size() && !found)
     {
         if (iterations > iterations_limit)
         {
-            std::cout << "[SmartAlgorithm] BFS aborted after too many iterations!" << std::endl;
+            if constexpr (config::get<bool>("verbose_debug"))
+            {
+                std::cout << "[SmartAlgorithm] BFS aborted after too many iterations!" << std::endl;
+            }
             break;
         }
-        
-        size_t layer_size = q.size(); // Number of states in the current layer
-        
+
+        size_t layer_end = search_->nodes.size(); // The current layer ends where the next one starts
+
         // Process all states in the current layer
-        for (size_t i = 0; i < layer_size; ++i)
+        for (size_t i = layer_begin; i < layer_end; ++i)
         {
-            BFSState current = q.front();
-            q.pop();
-            
+            // Counted for every state, so the limit bounds the search's memory even within one layer
+            if (++iterations > iterations_limit)
+            {
+                break;
+            }
+
+            // Copy, as expanding the state may grow search_->nodes
+            const BFSState current = search_->nodes[i].state;
+            const uint32_t current_index = static_cast<uint32_t>(i);
+
             if constexpr (config::get<bool>("verbose_debug"))
             {
                 // For debugging purposes
-                if (++iterations % 5000 == 0)
-                    std::cout << "Visited: " << visited.size() << ", Queue: " << q.size() << std::endl;
+                if (iterations % 5000 == 0)
+                    std::cout << "Visited: " << search_->nodes.size() << ", Queue: " << search_->nodes.size() - i - 1 << std::endl;
             }
 
             // If we have line of sight to the opponent, we found a shortest path, can add it to candidates
             Position opponent_pos;
+            if (current.cooldown == 0)
+            {
+                previous_search_.rays_read.set(current.pos_index * 8 + static_cast<size_t>(current.dir));
+            }
             if (current.cooldown == 0 &&
-                hasLineOfSightToOpponent(current.pos, current.dir, opponent_pos))
+                hasLineOfSightToOpponent(statePosition(current), current.dir, opponent_pos))
             {
                 // We require cooldown to be 0, because we want shortest path to shoot the opponent
                 found = true;
-                candidates.emplace_back(current, opponent_pos); // Store the state and opponent position
-                continue;                                       // Still process the rest of the layer
+                candidates.emplace_back(current_index, opponent_pos); // Store the node and opponent position
+                continue;                                             // Still process the rest of the layer
             }
 
             // Try GetBattleInfo for reducing cooldown
-            tryGetBattleInfo(q, parent, visited, current);
+            tryGetBattleInfo(current, current_index);
 
             // Try moving forward if safe
-            tryForwardMove(q, parent, visited, current);
+            tryForwardMove(current, current_index);
 
             // Try rotating in all directions
-            tryRotations(q, parent, visited, current);
+            tryRotations(current, current_index);
 
             // Try shooting a wall
-            tryShootingAWall(q, parent, visited, current);
+            tryShootingAWall(current, current_index);
         }
 
+        layer_begin = layer_end;
+
         // If we found a shortest path, we exit after finishing this layer
     }
 
@@ -467,14 +688,18 @@ std::optional<ActionRequest> SmartAlgorithm::findFirstSafeActionToOpponent()
     if (!candidates.empty())
     {
         // Choose the candidate closest to the opponent
+        auto distance = [this](const auto& candidate)
+        {
+            const BFSState& state = search_->nodes[candidate.first].state;
+            return getDistance(statePosition(state), candidate.second, state.dir, width_, height_);
+        };
         auto best = std::min_element(candidates.begin(), candidates.end(),
-                                     [this](const auto& a, const auto& b)
+                                     [&distance](const auto& a, const auto& b)
                                      {
-                                         return getDistance(a.first.pos, a.second, a.first.dir, width_, height_) <
-                                                getDistance(b.first.pos, b.second, b.first.dir, width_, height_);
+                                         return distance(a) < distance(b);
                                      });
 
-        return handleLineOfSightToOpponent(best->first, parent, start_state, best->second);
+        return handleLineOfSightToOpponent(best->first, best->second);
     }
 
     if constexpr (config::get<bool>("verbose_debug"))
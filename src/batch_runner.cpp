@@ -0,0 +1,124 @@
+#include "batch_runner.h"
+
+#include <algorithm>
+#include <filesystem>
+#include <future>
+#include <iostream>
+#include <optional>
+
+#include "game_manager.h"
+#include "global_config.h"
+#include "thread_pool.h"
+
+
+void BatchSummary::print(std::ostream& out) const
+{
+    out << "[Batch] Played " << games << " games, " << failed << " failed" << std::endl;
+
+    for (const auto& [player_id, count] : wins)
+    {
+        out << "[Batch] Player " << player_id << " won " << count << " games" << std::endl;
+    }
+
+    out << "[Batch] Ties: " << ties << std::endl;
+
+    if (timeouts > 0)
+    {
+        out << "[Batch] Algorithm timeouts: " << timeouts << std::endl;
+    }
+}
+
+BatchRunner::BatchRunner(const PlayerFactory& playerFactory, const TankAlgorithmFactory& algorithmFactory, size_t num_threads,
+                         bool record_replays, size_t action_threads)
+    : playerFactory_(playerFactory), algorithmFactory_(algorithmFactory), num_threads_(num_threads), record_replays_(record_replays),
+      action_threads_(action_threads) {}
+
+std::vector<std::string> BatchRunner::collectBoardFiles(const std::vector<std::string>& paths)
+{
+    const auto output_prefix = config::get<std::string_view>("output_file_prefix");
+    const auto input_error_file = config::get<std::string_view>("input_error_file");
+    std::vector<std::string> board_files;
+
+    for (const auto& path : paths)
+    {
+        if (!std::filesystem::is_directory(path))
+        {
+            board_files.push_back(path);
+            continue;
+        }
+
+        std::vector<std::string> directory_files;
+        for (const auto& entry : std::filesystem::directory_iterator(path))
+        {
+            const std::string name = entry.path().filename().string();
+            if (!entry.is_regular_file() || name.starts_with(output_prefix) || name == input_error_file)
+            {
+                continue; // Output files of previous runs are not boards
+            }
+            directory_files.push_back(entry.path().string());
+        }
+
+        // Directory order is unspecified, keep the batch reproducible
+        std::sort(directory_files.begin(), directory_files.end());
+        board_files.insert(board_files.end(), directory_files.begin(), directory_files.end());
+    }
+
+    return board_files;
+}
+
+BatchSummary BatchRunner::run(const std::vector<std::string>& board_files) const
+{
+    ThreadPool pool(num_threads_);
+    std::vector<std::future<std::optional<GameResult>>> games;
+    games.reserve(board_files.size());
+
+    for (const auto& board_file : board_files)
+    {
+        games.push_back(pool.submit([this, &board_file]() -> std::optional<GameResult>
+                                    {
+                                        // Every game owns its board, players and algorithms, nothing is shared between workers
+                                        GameOptions options{.headless = true, .record_replay = record_replays_, .action_threads = action_threads_};
+                                        GameManager game{playerFactory_, algorithmFactory_, options};
+                                        if (!game.readBoard(board_file))
+                                        {
+                                            return std::nullopt;
+                                        }
+                                        game.run();
+                                        return game.result();
+                                    }));
+    }
+
+    BatchSummary summary;
+    for (size_t i = 0; i < games.size(); ++i)
+    {
+        ++summary.games;
+
+        std::optional<GameResult> result;
+        try
+        {
+            result = games[i].get();
+        }
+        catch (const std::exception& exc)
+        {
+            std::cerr << "[Batch] An exception was thrown while playing " << board_files[i] << ": " << exc.what() << std::endl;
+        }
+
+        if (!result)
+        {
+            ++summary.failed;
+            continue;
+        }
+
+        summary.timeouts += result->timeouts;
+        if (result->winner == 0)
+        {
+            ++summary.ties;
+        }
+        else
+        {
+            ++summary.wins[result->winner];
+        }
+    }
+
+    return summary;
+}
@@ -1,25 +1,29 @@
 #include "board.h"
 
 #include <algorithm>
-#include <fstream>
+#include <cctype>
+#include <charconv>
 #include <iostream>
+#include <string_view>
 
 #include "Player.h"
 #include "algorithms/algorithm_utils.h"
 #include "board_satellite_view.h"
 #include "global_config.h"
 #include "input_errors_logger.h"
+#include "mapped_file.h"
+#include "zobrist.h"
 
 
 Board::Board(const PlayerFactory& playerFactory, const TankAlgorithmFactory& algorithmFactory)
     : playerFactory_(playerFactory), algorithmFactory_(algorithmFactory) {}
 
-std::vector<std::vector<Cell>>& Board::grid()
+Grid& Board::grid()
 {
     return grid_;
 }
 
-const std::vector<std::vector<Cell>>& Board::getGrid() const
+const Grid& Board::getGrid() const
 {
     return grid_;
 }
@@ -35,32 +39,63 @@ TankAlgorithm* Board::getAlgorithm(int player_id, int tank_id)
     return nullptr;
 }
 
+// Parses a metadata value the way std::stoi would, without throwing on a malformed one
+static bool parseMetadataValue(std::string_view text, size_t& target)
+{
+    while (!text.empty() && std::isspace(static_cast<unsigned char>(text.front())))
+    {
+        text.remove_prefix(1);
+    }
+    if (text.starts_with('+'))
+    {
+        text.remove_prefix(1);
+    }
+
+    int value = 0;
+    auto [end, error] = std::from_chars(text.data(), text.data() + text.size(), value);
+    if (error != std::errc())
+    {
+        return false;
+    }
+
+    target = static_cast<size_t>(value);
+    return true;
+}
+
 GameInfo Board::loadFromFile(const std::string& filename)
 {
-    InputErrorLogger error_logger;
-    std::ifstream file(filename);
+    InputErrorLogger error_logger(filename);
 
-    if (!file)
+    // The whole file is mapped and walked once, line by line, without copying the rows
+    MappedFile file(filename);
+    if (!file.is_valid())
     {
         error_logger.log("Couldn't open file: ", filename);
         return GameInfo();
     }
 
-    std::string line;
+    std::string_view remaining = file.contents();
+    auto next_line = [&remaining]() -> std::string_view
+    {
+        size_t end = remaining.find('\n');
+        std::string_view line = remaining.substr(0, end);
+        remaining.remove_prefix(end == std::string_view::npos ? remaining.size() : end + 1);
+        return line;
+    };
 
     // Skip line 1 (map name/description)
-    std::getline(file, line);
+    next_line();
 
-    auto parse_metadata = [&file, &line](const std::string& expected_key, size_t& target) -> bool
+    auto parse_metadata = [&next_line](std::string_view expected_key, size_t& target) -> bool
     {
-        std::getline(file, line);
+        std::string_view line = next_line();
         auto pos = line.find("=");
-        if (pos == std::string::npos || line.find(expected_key) == std::string::npos)
+        if (pos == std::string_view::npos || line.find(expected_key) == std::string_view::npos ||
+            !parseMetadataValue(line.substr(pos + 1), target))
         {
             std::cerr << "Missing or invalid line for " << expected_key << std::endl;
             return false;
         }
-        target = std::stoi(line.substr(pos + 1));
         return true;
     };
 
@@ -78,19 +113,16 @@ GameInfo Board::loadFromFile(const std::string& filename)
 
     std::vector<std::shared_ptr<Tank>> ordered_tanks;
 
-    grid_.resize(height_, std::vector<Cell>(width_));
+    grid_ = Grid(width_, height_);
 
     for (size_t y = 0; y < height_; ++y)
     {
-        std::getline(file, line);
+        // Missing rows and the missing end of short rows are left empty
+        std::string_view line = next_line();
         if (line.size() > width_)
         {
             error_logger.log("Warning: The width of the ", y, " row is wrong. Filling the missing cells and ignoring the extra cells.");
         }
-        else if (line.size() < width_)
-        {
-            line += std::string(width_ - line.size(), ' ');
-        }
 
         for (size_t x = 0; x < width_ && x < line.size(); ++x)
         {
@@ -100,12 +132,12 @@ GameInfo Board::loadFromFile(const std::string& filename)
             {
             case '#':
             {
-                grid_[x][y] = Cell(pos, std::make_shared<Wall>());
+                grid_.emplace<Wall>(pos);
                 break;
             }
             case '@':
             {
-                grid_[x][y] = Cell(pos, std::make_shared<Mine>());
+                grid_.emplace<Mine>(pos);
                 break;
             }
             case '1':
@@ -147,28 +179,43 @@ GameInfo Board::loadFromFile(const std::string& filename)
 
                 ordered_tanks.emplace_back(tank);
                 algorithms_[{player_index, tank_index}] = algorithmFactory_.create(player_index, tank_index);
-                grid_[x][y] = Cell(pos, tank);
+                grid_.at(x, y).addObject(tank.get());
                 break;
             }
             case '.':
             case ' ':
             {
-                grid_[x][y] = Cell(pos);
                 break;
             }
             default:
             {
                 // Unexpected character
                 error_logger.log("Warning: invalid character '", ch, "' at (", x, ",", y, "). Treating as empty.");
-                grid_[x][y] = Cell(pos);
                 break;
             }
             }
         }
     }
 
-    // Initialize prev_grid_ with the current grid state
-    prev_grid_ = grid_;
+    // Size the per step bookkeeping up front, so the game steps don't allocate
+    snapshot_dirty_cells_.reset(grid_.size());
+    cells_to_update_.reset(grid_.size());
+    first_shell_leaving_.assign(grid_.size(), kNoShell);
+    old_tanks_positions_.reserve(ordered_tanks.size());
+    destroyed_walls_.reserve(1); // A cell holds a single wall
+
+    // Initialize the previous turn snapshot and the hash with the current grid state
+    // Empty cells are already blank in the snapshot and add nothing to the hash
+    prev_snapshot_ = SatelliteSnapshot(width_, height_);
+    cells_hash_ = 0;
+    for (size_t i = 0; i < grid_.size(); ++i)
+    {
+        const Cell& cell = grid_.cell(i);
+        if (cell.empty())
+            continue;
+        prev_snapshot_.data()[i] = BoardSatelliteView::cellToChar(cell); // Same row-major layout as the grid
+        toggleCellHash(cell);
+    }
 
     GameInfo game_info(width_, height_, max_steps, num_shells, std::move(ordered_tanks));
     return game_info;
@@ -205,7 +252,7 @@ const std::vector<std::shared_ptr<Tank>>& Board::getPlayerTanks(int player_id) c
     return empty_vector; // Return empty vector if invalid player id
 }
 
-bool Board::executeTankAction(std::shared_ptr<Tank> tank, ActionRequest& action)
+bool Board::executeTankAction(const std::shared_ptr<Tank>& tank, ActionRequest& action)
 {
     if (!tank || !tank->isAlive())
     {
@@ -229,19 +276,19 @@ bool Board::executeTankAction(std::shared_ptr<Tank> tank, ActionRequest& action)
 
         tank->setWaitingBackMove(false);
         action = ActionRequest::MoveBackward;
-        return moveTankBackward(tank, current_pos);
+        return moveTankBackward(*tank, current_pos);
     }
 
     switch (action)
     {
     case ActionRequest::MoveForward:
     {
-        return moveTankForward(tank, current_pos);
+        return moveTankForward(*tank, current_pos);
     }
 
     case ActionRequest::MoveBackward:
     {
-        return handleBackMovement(tank, current_pos);
+        return handleBackMovement(*tank, current_pos);
     }
 
     case ActionRequest::RotateLeft45:
@@ -252,22 +299,22 @@ bool Board::executeTankAction(std::shared_ptr<Tank> tank, ActionRequest& action)
         [[fallthrough]];
     case ActionRequest::RotateRight90:
     {
-        return rotateTank(tank, action);
+        return rotateTank(*tank, action);
     }
 
     case ActionRequest::Shoot:
     {
-        return shoot(tank, current_pos);
+        return shoot(*tank, current_pos);
     }
 
     case ActionRequest::GetBattleInfo:
     {
-        return getBattleInfo(tank);
+        return getBattleInfo(*tank);
     }
 
     case ActionRequest::DoNothing:
     {
-        return doNothing(tank);
+        return doNothing(*tank);
     }
 
     default:
@@ -275,243 +322,282 @@ bool Board::executeTankAction(std::shared_ptr<Tank> tank, ActionRequest& action)
     }
 }
 
-bool Board::moveTankForward(std::shared_ptr<Tank> tank, const Position& current_pos)
+bool Board::moveTankForward(Tank& tank, const Position& current_pos)
 {
     if constexpr (config::get<bool>("verbose_debug"))
-        std::cout << "[Board] Executing MoveForward for Tank " << tank->tankId() << " of Player " << tank->playerId() << std::endl;
+        std::cout << "[Board] Executing MoveForward for Tank " << tank.tankId() << " of Player " << tank.playerId() << std::endl;
 
-    if (tank->isBacking())
+    if (tank.isBacking())
     {
         // Only move forward action is able to reset the back movement
-        tank->resetBackwait();
+        tank.resetBackwait();
         return true;
     }
 
-    Position new_pos = forwardPosition(current_pos, tank->direction(), width_, height_);
+    Position new_pos = forwardPosition(current_pos, tank.direction(), width_, height_);
 
-    Cell& current_cell = grid_[current_pos.first][current_pos.second];
-    Cell& new_cell = grid_[new_pos.first][new_pos.second];
-
-    if (new_cell.has(ObjectType::Wall))
+    if (grid_[new_pos].has(ObjectType::Wall))
     {
         // Illegal move, can't move into walls
         return false;
     }
 
-    new_cell.addObject(tank);
-    current_cell.removeObject(tank);
-    tank->position() = new_pos;
-    cells_to_update_.insert(new_pos);
+    addObjectToCell(new_pos, &tank);
+    removeObjectFromCell(current_pos, &tank);
+    tank.position() = new_pos;
+    cells_to_update_.insert(grid_.index(new_pos));
 
-    // Store the old position of the tank
-    // Should never be two tanks in the same position in a valid game state, so should be ok
-    old_tanks_positions_[current_pos] = tank;
+    recordOldTankPosition(current_pos, tank);
 
     return true;
 }
 
-bool Board::shoot(std::shared_ptr<Tank> tank, const Position& current_pos)
+bool Board::shoot(Tank& tank, const Position& current_pos)
 {
     if constexpr (config::get<bool>("verbose_debug"))
-        std::cout << "[Board] Executing Shoot for Tank " << tank->tankId() << " of Player " << tank->playerId() << std::endl;
+        std::cout << "[Board] Executing Shoot for Tank " << tank.tankId() << " of Player " << tank.playerId() << std::endl;
 
-    tank->tickBackwait();
+    tank.tickBackwait();
 
-    if (tank->canShoot())
+    if (tank.canShoot())
     {
-        Position shell_pos = forwardPosition(current_pos, tank->direction(), width_, height_);
-        auto& cell = grid_[shell_pos.first][shell_pos.second];
-        tank->shoot();
-        std::shared_ptr<Shell> shell = std::make_shared<Shell>(tank->direction());
-        cell.addObject(shell);
-        active_shells_.emplace_back(shell_pos, shell);
-        cells_to_update_.insert(shell_pos);
+        Position shell_pos = forwardPosition(current_pos, tank.direction(), width_, height_);
+        tank.shoot();
+        Shell* shell = grid_.create<Shell>(tank.direction());
+        if (journaling())
+            journal({JournalEntry::Kind::ShellCreated, 0, shell});
+        addObjectToCell(shell_pos, shell);
+        addActiveShell(shell_pos, shell);
+        cells_to_update_.insert(grid_.index(shell_pos));
         return true;
     }
 
     return false;
 }
 
-bool Board::getBattleInfo(std::shared_ptr<Tank> tank)
+bool Board::getBattleInfo(Tank& tank)
 {
     if constexpr (config::get<bool>("verbose_debug"))
-        std::cout << "[Board] Executing GetBattleInfo for Tank " << tank->tankId() << " of Player " << tank->playerId() << std::endl;
+        std::cout << "[Board] Executing GetBattleInfo for Tank " << tank.tankId() << " of Player " << tank.playerId() << std::endl;
 
-    bool is_backing = tank->isBacking();
-    tank->tickBackwait();
+    bool is_backing = tank.isBacking();
+    tank.tickBackwait();
     if (is_backing)
     {
         return false;
     }
 
-    auto player_it = player_tanks_.find(tank->playerId());
+    auto player_it = player_tanks_.find(tank.playerId());
     if (player_it == player_tanks_.end())
     {
         // Player not found, return false
         if constexpr (config::get<bool>("verbose_debug"))
-            std::cerr << "[Board] Player " << tank->playerId() << " not found for GetBattleInfo." << std::endl;
+            std::cerr << "[Board] Player " << tank.playerId() << " not found for GetBattleInfo." << std::endl;
         return false;
     }
 
     // Provide satellite view to the player
-    BoardSatelliteView satelliteView(prev_grid_, tank->position());
-    auto algorithm = getAlgorithm(tank->playerId(), tank->tankId());
+    BoardSatelliteView satelliteView(prev_snapshot_, tank.position());
+    auto algorithm = getAlgorithm(tank.playerId(), tank.tankId());
     if (!algorithm)
     {
         // Algorithm not found, return false
         if constexpr (config::get<bool>("verbose_debug"))
-            std::cerr << "[Board] Algorithm not found for Player " << tank->playerId()
-                      << " Tank " << tank->tankId() << " for GetBattleInfo." << std::endl;
+            std::cerr << "[Board] Algorithm not found for Player " << tank.playerId()
+                      << " Tank " << tank.tankId() << " for GetBattleInfo." << std::endl;
         return false;
     }
 
+    if (journaling())
+    {
+        // Simulating ahead, the players must not see boards that never happen
+        return true;
+    }
+
     player_it->second.first->updateTankWithBattleInfo(*algorithm, satelliteView);
 
     return true;
 }
 
-bool Board::doNothing(std::shared_ptr<Tank> tank)
+bool Board::doNothing(Tank& tank)
 {
     if constexpr (config::get<bool>("verbose_debug"))
-        std::cout << "[Board] Executing DoNothing for Tank " << tank->tankId() << " of Player " << tank->playerId() << std::endl;
+        std::cout << "[Board] Executing DoNothing for Tank " << tank.tankId() << " of Player " << tank.playerId() << std::endl;
 
-    bool is_backing = tank->isBacking();
-    tank->tickBackwait();
+    bool is_backing = tank.isBacking();
+    tank.tickBackwait();
     return !is_backing;
 }
 
-bool Board::moveTankBackward(std::shared_ptr<Tank> tank, const Position& current_pos)
+bool Board::moveTankBackward(Tank& tank, const Position& current_pos)
 {
-    Position new_pos = backwardPosition(tank->position(), tank->direction(), width_, height_);
-
-    Cell& current_cell = grid_[current_pos.first][current_pos.second];
-    Cell& new_cell = grid_[new_pos.first][new_pos.second];
+    Position new_pos = backwardPosition(tank.position(), tank.direction(), width_, height_);
 
-    if (new_cell.has(ObjectType::Wall))
+    if (grid_[new_pos].has(ObjectType::Wall))
     {
         // Illegal move, can't move into walls
         return false;
     }
 
-    new_cell.addObject(tank);
-    current_cell.removeObject(tank);
-    tank->position() = new_pos;
-    cells_to_update_.insert(new_pos);
+    addObjectToCell(new_pos, &tank);
+    removeObjectFromCell(current_pos, &tank);
+    tank.position() = new_pos;
+    cells_to_update_.insert(grid_.index(new_pos));
 
-    // Store the old position of the tank
-    // Should never be two tanks in the same position in a valid game state, so should be ok
-    old_tanks_positions_[current_pos] = tank;
+    recordOldTankPosition(current_pos, tank);
 
     return true;
 }
 
-bool Board::handleBackMovement(std::shared_ptr<Tank> tank, const Position& current_pos)
+bool Board::handleBackMovement(Tank& tank, const Position& current_pos)
 {
     if constexpr (config::get<bool>("verbose_debug"))
-        std::cout << "[Board] Executing MoveBackward for Tank " << tank->tankId() << " of Player " << tank->playerId() << std::endl;
+        std::cout << "[Board] Executing MoveBackward for Tank " << tank.tankId() << " of Player " << tank.playerId() << std::endl;
 
-    if (!tank->isBacking() && tank->lastAction() != ActionRequest::MoveBackward)
+    if (!tank.isBacking() && tank.lastAction() != ActionRequest::MoveBackward)
     {
-        tank->startBackwait();
-        tank->setWaitingBackMove(true);
+        tank.startBackwait();
+        tank.setWaitingBackMove(true);
         return true;
     }
     else
     {
-        if (tank->lastAction() != ActionRequest::MoveBackward)
+        if (tank.lastAction() != ActionRequest::MoveBackward)
         {
-            tank->tickBackwait(); // keep counting
+            tank.tickBackwait(); // keep counting
         }
 
-        if (tank->readyToMoveBack())
+        if (tank.readyToMoveBack())
         {
             return moveTankBackward(tank, current_pos);
         }
 
-        if (tank->lastAction() == ActionRequest::MoveBackward)
+        if (tank.lastAction() == ActionRequest::MoveBackward)
         {
-            tank->tickBackwait();
+            tank.tickBackwait();
         }
     }
 
     return false; // still waiting (Asking moving back while waiting for a move back should be ignored)
 }
 
-bool Board::rotateTank(std::shared_ptr<Tank> tank, ActionRequest action)
+bool Board::rotateTank(Tank& tank, ActionRequest action)
 {
     if constexpr (config::get<bool>("verbose_debug"))
-        std::cout << "[Board] Executing " << tankActionToString(action) << " for Tank " << tank->tankId() << " of Player " << tank->playerId() << std::endl;
+        std::cout << "[Board] Executing " << tankActionToString(action) << " for Tank " << tank.tankId() << " of Player " << tank.playerId() << std::endl;
 
-    bool is_backing = tank->isBacking();
-    tank->tickBackwait();
+    bool is_backing = tank.isBacking();
+    tank.tickBackwait();
     if (is_backing)
     {
         return false;
     }
 
-    tank->direction() = getDirectionAfterRotation(tank->direction(), action);
+    size_t cell_index = grid_.index(tank.position());
+    cells_hash_ ^= zobrist::objectKey(cell_index, tank);
+    tank.direction() = getDirectionAfterRotation(tank.direction(), action);
+    cells_hash_ ^= zobrist::objectKey(cell_index, tank);
     return true;
 }
 
-// Moves all the shells one step forward, does not resolve collisions (besides crossing shells)
-void Board::updateActiveShells()
+void Board::addActiveShell(const Position& pos, Shell* shell)
 {
-    std::vector<std::tuple<Position, Position, std::shared_ptr<Shell>>> moves; // (from, to, shell)
-
-    // First pass: prepeare moves
-    for (const auto& [pos, shell] : active_shells_)
+    size_t slot = active_shells_.size();
+    if (!free_shell_slots_.empty())
     {
-        Position new_pos = forwardPosition(pos, shell->direction(), width_, height_);
-        moves.emplace_back(pos, new_pos, shell);
+        slot = free_shell_slots_.back();
+        free_shell_slots_.pop_back();
+        if (journaling())
+            journal({JournalEntry::Kind::FreeSlotPopped, slot});
+    }
+    else
+    {
+        active_shells_.emplace_back();
+        if (journaling())
+            journal({JournalEntry::Kind::ShellSlotsGrown});
+
+        // Grow the per slot scratch space with the slots, instead of in the next shells step
+        shell_destinations_.resize(active_shells_.size());
+        crossing_shells_.resize(active_shells_.size());
+        next_shell_leaving_.resize(active_shells_.size());
+        free_shell_slots_.reserve(active_shells_.size());
+        exploded_shell_slots_.reserve(active_shells_.size());
     }
 
-    std::unordered_set<std::shared_ptr<Shell>> shells_to_remove;
+    shell->setSlot(slot);
+    setActiveShell(slot, pos, shell);
+}
+
+void Board::removeActiveShell(size_t slot)
+{
+    releaseObject(active_shells_[slot].second);
+    setActiveShell(slot, active_shells_[slot].first, nullptr);
+    free_shell_slots_.push_back(slot);
+    if (journaling())
+        journal({JournalEntry::Kind::FreeSlotPushed});
+}
+
+void Board::setActiveShell(size_t slot, const Position& pos, Shell* shell)
+{
+    if (journaling())
+        journal({JournalEntry::Kind::ActiveShellSet, slot, active_shells_[slot].second, active_shells_[slot].first});
+    active_shells_[slot] = {pos, shell};
+}
 
-    // Check for collisions (crossing shells)
-    for (size_t i = 0; i < moves.size(); ++i)
+// Moves all the shells one step forward, does not resolve collisions (besides crossing shells)
+void Board::updateActiveShells()
+{
+    // First pass: prepeare moves and check for collisions (crossing shells)
+    // Shells are linked in a list per cell they leave, so a shell crossing another one is found by
+    // going over the shells leaving its destination, instead of comparing every pair of moves
+    for (size_t slot = 0; slot < active_shells_.size(); ++slot)
     {
-        for (size_t j = i + 1; j < moves.size(); ++j)
-        {
-            auto& [from1, to1, shell1] = moves[i];
-            auto& [from2, to2, shell2] = moves[j];
+        const auto& [from, shell] = active_shells_[slot];
+        if (!shell)
+            continue;
+
+        const Position to = forwardPosition(from, shell->direction(), width_, height_);
+        shell_destinations_[slot] = to;
+        crossing_shells_[slot] = false;
 
-            if (to1 == from2 && to2 == from1)
+        for (size_t other = first_shell_leaving_[grid_.index(to)]; other != kNoShell; other = next_shell_leaving_[other])
+        {
+            if (shell_destinations_[other] == from)
             {
                 // Shells are crossing each other, should mark as collision
-                shells_to_remove.insert(shell1);
-                shells_to_remove.insert(shell2);
+                crossing_shells_[slot] = true;
+                crossing_shells_[other] = true;
             }
         }
+
+        size_t from_index = grid_.index(from);
+        next_shell_leaving_[slot] = first_shell_leaving_[from_index];
+        first_shell_leaving_[from_index] = slot;
     }
 
     // Second pass: move shells on the board, excluding removed shells
-    for (auto& [from, to, shell] : moves)
+    for (size_t slot = 0; slot < active_shells_.size(); ++slot)
     {
-        grid_[from.first][from.second].removeObject(shell);
-        if (shells_to_remove.count(shell) == 0)
-        {
-            grid_[to.first][to.second].addObject(shell);
-            cells_to_update_.insert(to);
+        auto& [from, shell] = active_shells_[slot];
+        if (!shell)
+            continue;
 
-            // Update the position in active_shells_
-            auto it = std::find_if(active_shells_.begin(), active_shells_.end(), [&shell](const auto& p)
-                                   { return p.second == shell; });
-            if (it != active_shells_.end())
-            {
-                it->first = to; // update position
-            }
+        first_shell_leaving_[grid_.index(from)] = kNoShell; // Clean up for the next step
+
+        removeObjectFromCell(from, shell);
+        if (!crossing_shells_[slot])
+        {
+            const Position& to = shell_destinations_[slot];
+            addObjectToCell(to, shell);
+            cells_to_update_.insert(grid_.index(to));
+            setActiveShell(slot, to, shell); // Update the position of the active shell
+        }
+        else
+        {
+            // Crossing shell, should be removed from the active shells
+            removeActiveShell(slot);
         }
-        // Else: crossing shell, should be removed
     }
-
-    // Remove crossing shells from the active shells list
-    active_shells_.erase(std::remove_if(active_shells_.begin(), active_shells_.end(),
-                                        [&shells_to_remove](const auto& pair)
-                                        {
-                                            const auto& shell = pair.second;
-                                            return shells_to_remove.count(shell) > 0;
-                                        }),
-                         active_shells_.end());
 }
 
 void Board::resolveCollisions(Cell& cell)
@@ -530,86 +616,89 @@ void Board::resolveCollisions(Cell& cell)
     else if (cell.getObjectsByType(ObjectType::Tank).size() > 1)
     {
         // Two (or more) tanks collided, all are destroyed
-        for (auto& tank : cell.getObjectsByType(ObjectType::Tank))
+        toggleCellHash(cell);
+        for (auto* tank : cell.getObjectsByType(ObjectType::Tank))
         {
-            auto tank_ptr = std::static_pointer_cast<Tank>(tank);
-            tank_ptr->destroy();
+            static_cast<Tank*>(tank)->destroy();
         }
 
         // Remove all tanks from the cell
-        cell.removeObjectsByType(ObjectType::Tank);
+        removeObjectsFromCell(cell, ObjectType::Tank);
+        toggleCellHash(cell);
+        snapshot_dirty_cells_.insert(grid_.index(cell));
     }
 }
 
 void Board::onExplosion(Cell& cell)
 {
     // We have an explosion, all the objects must get hurt
-
-    std::vector<std::shared_ptr<GameObjectInterface>> objects_to_remove;
+    // The cell is hashed out as it was and back in as it's left, walls change with their hits
+    toggleCellHash(cell);
 
     // Weaken wall if exists
     if (cell.has(ObjectType::Wall))
     {
-        for (auto& wall : cell.getObjectsByType(ObjectType::Wall))
+        destroyed_walls_.clear();
+        for (auto* wall : cell.getObjectsByType(ObjectType::Wall))
         {
-            auto wall_ptr = std::static_pointer_cast<Wall>(wall);
-            wall_ptr->weaken();
+            auto* wall_ptr = static_cast<Wall*>(wall);
+            weakenWall(*wall_ptr);
             if (wall_ptr->isDestroyed())
             {
-                objects_to_remove.push_back(wall);
+                destroyed_walls_.push_back(wall);
             }
         }
+
+        // Remove after the loop, to avoid invalidating the cell's objects span
+        for (auto* wall : destroyed_walls_)
+        {
+            cell.removeObject(wall);
+            if (journaling())
+                journal({JournalEntry::Kind::ObjectRemoved, grid_.index(cell), wall});
+            releaseObject(wall);
+        }
     }
 
     // Destroy all tanks
     if (cell.has(ObjectType::Tank))
     {
-        for (auto& tank : cell.getObjectsByType(ObjectType::Tank))
+        for (auto* tank : cell.getObjectsByType(ObjectType::Tank))
         {
-            auto tank_ptr = std::static_pointer_cast<Tank>(tank);
-            tank_ptr->destroy();
-            objects_to_remove.push_back(tank);
+            static_cast<Tank*>(tank)->destroy();
         }
+        removeObjectsFromCell(cell, ObjectType::Tank);
     }
 
     // Destroy all shells
     if (cell.has(ObjectType::Shell))
     {
-        for (auto& shell : cell.getObjectsByType(ObjectType::Shell))
+        exploded_shell_slots_.clear();
+        for (auto* shell : cell.getObjectsByType(ObjectType::Shell))
         {
-            auto shell_ptr = std::static_pointer_cast<Shell>(shell);
-
             // Remove the shell from the active shells list
-            Position shell_position = cell.position();
-            auto it = std::find_if(active_shells_.begin(), active_shells_.end(),
-                                   [&shell_position, &shell_ptr](const std::pair<Position, std::shared_ptr<Shell>>& active_shell)
-                                   {
-                                       return active_shell.first == shell_position && active_shell.second == shell_ptr;
-                                   });
-            if (it != active_shells_.end())
+            size_t slot = static_cast<Shell*>(shell)->slot();
+            if (slot < active_shells_.size() && active_shells_[slot].second == shell)
             {
-                active_shells_.erase(it);
+                exploded_shell_slots_.push_back(slot);
             }
+        }
 
-            // Mark for removal from the cell
-            objects_to_remove.push_back(shell);
+        // The shells are released through their active slots, only once they left the cell
+        removeObjectsFromCell(cell, ObjectType::Shell);
+        for (size_t slot : exploded_shell_slots_)
+        {
+            removeActiveShell(slot);
         }
     }
 
     // Destroy mine if exists
     if (cell.has(ObjectType::Mine))
     {
-        for (auto& mine : cell.getObjectsByType(ObjectType::Mine))
-        {
-            objects_to_remove.push_back(mine);
-        }
+        removeObjectsFromCell(cell, ObjectType::Mine);
     }
 
-    // Remove all collected objects safely, to avoid invalidating iterators
-    for (auto& object : objects_to_remove)
-    {
-        cell.removeObject(object);
-    }
+    toggleCellHash(cell);
+    snapshot_dirty_cells_.insert(grid_.index(cell));
 }
 
 void Board::doShellsStep(bool shells_only)
@@ -622,9 +711,9 @@ void Board::doShellsStep(bool shells_only)
 
     if (shells_only)
     {
-        // Update the previous grid with the current grid
+        // Update the previous turn snapshot with the current grid
         // Only in shells-only step, for saving the previous turn state for GetBattleInfo
-        prev_grid_ = grid_;
+        refreshSnapshot();
     }
 }
 
@@ -636,19 +725,19 @@ void Board::update()
         for (auto it2 = std::next(it1); it2 != old_tanks_positions_.end(); ++it2)
         {
             Position old_pos1 = it1->first;
-            auto tank1 = it1->second;
+            Tank* tank1 = it1->second;
 
             Position old_pos2 = it2->first;
-            auto tank2 = it2->second;
+            Tank* tank2 = it2->second;
 
             if (tank1->position() == old_pos2 && tank2->position() == old_pos1)
             {
                 // Tanks are crossing each other, both should be destroyed
                 tank1->destroy();
-                grid_[tank1->position().first][tank1->position().second].removeObject(tank1);
+                removeObjectFromCell(tank1->position(), tank1);
 
                 tank2->destroy();
-                grid_[tank2->position().first][tank2->position().second].removeObject(tank2);
+                removeObjectFromCell(tank2->position(), tank2);
             }
         }
     }
@@ -657,20 +746,68 @@ void Board::update()
     old_tanks_positions_.clear();
 
     // Resolve collisions for all the cells from this turn
-    for (auto& cell_pos : cells_to_update_)
+    for (size_t cell_index : cells_to_update_)
     {
-        resolveCollisions(grid_[cell_pos.first][cell_pos.second]);
+        resolveCollisions(grid_.cell(cell_index));
     }
 
     // Clear the cells to update set for the next turn
     cells_to_update_.clear();
 }
 
+// Store the old position of the tank
+void Board::recordOldTankPosition(const Position& pos, Tank& tank)
+{
+    // Should never be two tanks in the same position in a valid game state, so should be ok
+    for (auto& [old_pos, old_tank] : old_tanks_positions_)
+    {
+        if (old_pos == pos)
+        {
+            old_tank = &tank;
+            return;
+        }
+    }
+
+    old_tanks_positions_.emplace_back(pos, &tank);
+}
+
+void Board::addObjectToCell(const Position& pos, GameObjectInterface* object)
+{
+    grid_[pos].addObject(object);
+    size_t cell_index = grid_.index(pos);
+    cells_hash_ ^= zobrist::objectKey(cell_index, *object);
+    if (journaling())
+        journal({JournalEntry::Kind::ObjectAdded, cell_index, object});
+    snapshot_dirty_cells_.insert(cell_index);
+}
+
+void Board::removeObjectFromCell(const Position& pos, GameObjectInterface* object)
+{
+    grid_[pos].removeObject(object);
+    size_t cell_index = grid_.index(pos);
+    cells_hash_ ^= zobrist::objectKey(cell_index, *object);
+    if (journaling())
+        journal({JournalEntry::Kind::ObjectRemoved, cell_index, object});
+    snapshot_dirty_cells_.insert(cell_index);
+}
+
+// Re-encodes only the cells that changed since the last refresh, instead of copying the whole grid
+void Board::refreshSnapshot()
+{
+    for (size_t cell_index : snapshot_dirty_cells_)
+    {
+        const Cell& cell = grid_.cell(cell_index);
+        if (journaling())
+            journal({JournalEntry::Kind::SnapshotChanged, cell_index, nullptr, {}, static_cast<unsigned char>(prev_snapshot_.data()[cell_index])});
+        prev_snapshot_.data()[cell_index] = BoardSatelliteView::cellToChar(cell);
+    }
+
+    snapshot_dirty_cells_.clear();
+}
+
 const Cell& Board::getCell(Position position) const
 {
-    int x = position.first % width_;
-    int y = position.second % height_;
-    return grid_[x][y];
+    return grid_.at(position.first % width_, position.second % height_);
 }
 
 size_t Board::getHeight() const
@@ -682,3 +819,171 @@ size_t Board::getWidth() const
 {
     return width_;
 }
+
+void Board::toggleCellHash(const Cell& cell)
+{
+    cells_hash_ ^= zobrist::cellKey(grid_.index(cell), cell);
+}
+
+uint64_t Board::hash() const
+{
+    return cells_hash_ ^ tanksStateHash();
+}
+
+uint64_t Board::computeHash() const
+{
+    uint64_t hash = tanksStateHash();
+    for (const auto& cell : grid_)
+    {
+        hash ^= zobrist::cellKey(grid_.index(cell), cell);
+    }
+    return hash;
+}
+
+uint64_t Board::tanksStateHash() const
+{
+    uint64_t hash = 0;
+    for (const auto& [player_id, player_and_tanks] : player_tanks_)
+    {
+        for (const auto& tank : player_and_tanks.second)
+        {
+            hash ^= zobrist::tankStateKey(*tank);
+        }
+    }
+    return hash;
+}
+
+// Removes the objects one by one, so every removal can be journaled
+void Board::removeObjectsFromCell(Cell& cell, ObjectType type)
+{
+    if (journaling())
+    {
+        size_t cell_index = grid_.index(cell);
+        for (auto* object : cell.getObjectsByType(type))
+        {
+            journal({JournalEntry::Kind::ObjectRemoved, cell_index, object});
+        }
+    }
+    cell.removeObjectsByType(type);
+}
+
+// Objects released while journaling are kept alive until the outermost checkpoint is committed, a rollback revives them
+void Board::releaseObject(GameObjectInterface* object)
+{
+    if (journaling())
+    {
+        deferred_releases_.push_back(object);
+        return;
+    }
+
+    if (object->type() == ObjectType::Shell)
+        grid_.release(static_cast<Shell*>(object));
+    else if (object->type() == ObjectType::Wall)
+        grid_.release(static_cast<Wall*>(object));
+}
+
+void Board::weakenWall(Wall& wall)
+{
+    if (journaling())
+        journal({JournalEntry::Kind::WallWeakened, 0, &wall, {}, wall.hitCount()});
+    wall.weaken();
+}
+
+void Board::journal(const JournalEntry& entry)
+{
+    journal_.push_back(entry);
+}
+
+Board::Checkpoint Board::checkpoint()
+{
+    Checkpoint checkpoint{journal_.size(), tank_states_.size(), deferred_releases_.size(), cells_hash_};
+
+    // Tanks change in many ways during a step, there are few of them so they're saved whole
+    for (const auto& [player_id, player_and_tanks] : player_tanks_)
+    {
+        for (const auto& tank : player_and_tanks.second)
+        {
+            tank_states_.emplace_back(tank.get(), tank->runtimeState());
+        }
+    }
+
+    ++open_checkpoints_;
+    return checkpoint;
+}
+
+void Board::rollback(const Checkpoint& checkpoint)
+{
+    while (journal_.size() > checkpoint.journal_size)
+    {
+        undo(journal_.back());
+        journal_.pop_back();
+    }
+
+    for (size_t i = checkpoint.tank_states_size; i < tank_states_.size(); ++i)
+    {
+        tank_states_[i].first->restoreRuntimeState(tank_states_[i].second);
+    }
+    tank_states_.resize(checkpoint.tank_states_size);
+
+    // The objects released since the checkpoint are back on the board
+    deferred_releases_.resize(checkpoint.deferred_releases_size);
+    cells_hash_ = checkpoint.cells_hash;
+
+    // Checkpoints are taken between rounds, when the per step bookkeeping is empty
+    old_tanks_positions_.clear();
+    cells_to_update_.clear();
+    snapshot_dirty_cells_.clear();
+
+    --open_checkpoints_;
+}
+
+void Board::commit(const Checkpoint& checkpoint)
+{
+    tank_states_.resize(checkpoint.tank_states_size);
+    --open_checkpoints_;
+
+    if (open_checkpoints_ == 0)
+    {
+        // Nothing can be undone anymore
+        journal_.clear();
+        for (auto* object : deferred_releases_)
+        {
+            releaseObject(object);
+        }
+        deferred_releases_.clear();
+    }
+}
+
+void Board::undo(const JournalEntry& entry)
+{
+    switch (entry.kind)
+    {
+    case JournalEntry::Kind::ObjectAdded:
+        grid_.cell(entry.index).removeObject(entry.object);
+        break;
+    case JournalEntry::Kind::ObjectRemoved:
+        grid_.cell(entry.index).addObject(entry.object);
+        break;
+    case JournalEntry::Kind::ShellCreated:
+        grid_.release(static_cast<Shell*>(entry.object));
+        break;
+    case JournalEntry::Kind::ActiveShellSet:
+        active_shells_[entry.index] = {entry.position, static_cast<Shell*>(entry.object)};
+        break;
+    case JournalEntry::Kind::ShellSlotsGrown:
+        active_shells_.pop_back();
+        break;
+    case JournalEntry::Kind::FreeSlotPushed:
+        free_shell_slots_.pop_back();
+        break;
+    case JournalEntry::Kind::FreeSlotPopped:
+        free_shell_slots_.push_back(entry.index);
+        break;
+    case JournalEntry::Kind::WallWeakened:
+        static_cast<Wall*>(entry.object)->setHitCount(entry.value);
+        break;
+    case JournalEntry::Kind::SnapshotChanged:
+        prev_snapshot_.data()[entry.index] = static_cast<char>(entry.value);
+        break;
+    }
+}
@@ -0,0 +1,99 @@
+#include "board_generator.h"
+
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+
+bool BoardGenerator::is_valid() const
+{
+    size_t cells = options_.width * options_.height;
+    size_t tanks = options_.players * options_.tanks_per_player;
+    size_t obstacles = static_cast<size_t>((options_.wall_density + options_.mine_density) * static_cast<double>(cells));
+
+    return cells > 0 && options_.players >= 1 && options_.players <= 9 &&
+           options_.wall_density >= 0 && options_.mine_density >= 0 && tanks + obstacles <= cells;
+}
+
+std::string BoardGenerator::generate() const
+{
+    if (!is_valid())
+    {
+        return {};
+    }
+
+    const size_t cells = options_.width * options_.height;
+    std::vector<char> board(cells, ' ');
+
+    // Only the raw engine output is specified by the standard, the distributions differ between
+    // standard libraries, so the cells are shuffled by hand to get the same board everywhere
+    std::mt19937_64 engine(options_.seed);
+    std::vector<size_t> order(cells);
+    for (size_t i = 0; i < cells; ++i)
+    {
+        order[i] = i;
+    }
+    for (size_t i = cells - 1; i > 0; --i)
+    {
+        std::swap(order[i], order[engine() % (i + 1)]);
+    }
+
+    // Tanks first, in player order, then walls, then mines, each on its own cell
+    size_t next = 0;
+    for (size_t player = 1; player <= options_.players; ++player)
+    {
+        for (size_t tank = 0; tank < options_.tanks_per_player; ++tank)
+        {
+            board[order[next++]] = static_cast<char>('0' + player);
+        }
+    }
+
+    size_t walls = static_cast<size_t>(options_.wall_density * static_cast<double>(cells));
+    size_t mines = static_cast<size_t>(options_.mine_density * static_cast<double>(cells));
+    for (size_t i = 0; i < walls; ++i)
+    {
+        board[order[next++]] = '#';
+    }
+    for (size_t i = 0; i < mines; ++i)
+    {
+        board[order[next++]] = '@';
+    }
+
+    std::string text;
+    text.reserve(cells + options_.height + 128);
+    text += "Generated board, seed " + std::to_string(options_.seed) + "\n";
+    text += "MaxSteps = " + std::to_string(options_.max_steps) + "\n";
+    text += "NumShells = " + std::to_string(options_.num_shells) + "\n";
+    text += "Rows = " + std::to_string(options_.height) + "\n";
+    text += "Cols = " + std::to_string(options_.width) + "\n";
+    for (size_t y = 0; y < options_.height; ++y)
+    {
+        text.append(board.data() + y * options_.width, options_.width);
+        text += '\n';
+    }
+
+    return text;
+}
+
+bool BoardGenerator::writeToFile(const std::string& filename) const
+{
+    if (!is_valid())
+    {
+        std::cerr << "Warning: Can't generate a board with these options" << std::endl;
+        return false;
+    }
+
+    std::ofstream out(filename, std::ios::binary);
+    if (!out)
+    {
+        std::cerr << "Warning: Failed to open board file: " << filename << std::endl;
+        return false;
+    }
+
+    std::string text = generate();
+    out.write(text.data(), static_cast<std::streamsize>(text.size()));
+    return static_cast<bool>(out);
+}
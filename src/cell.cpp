@@ -1,50 +1,116 @@
 #include "cell.h"
 
 #include <algorithm>
+#include <utility>
 
 
-Cell::Cell(Position position, std::shared_ptr<GameObjectInterface> object) : position_(position)
+Cell::~Cell()
 {
-    if (object)
+    if (overflowing())
+        delete overflow_;
+}
+
+Cell::Cell(Cell&& other) noexcept
+{
+    *this = std::move(other);
+}
+
+Cell& Cell::operator=(Cell&& other) noexcept
+{
+    if (this != &other)
     {
-        objects_[object->type()].push_back(object);
+        clear();
+
+        occupancy_ = other.occupancy_;
+        size_ = other.size_;
+        counts_ = other.counts_;
+        if (other.overflowing())
+            overflow_ = other.overflow_; // Taken over, other doesn't delete it once emptied
+        else
+            inline_objects_ = other.inline_objects_;
+
+        other.size_ = 0;
+        other.counts_ = {};
+        other.occupancy_ = 0;
     }
+    return *this;
 }
 
-Position& Cell::position()
+size_t Cell::typeBegin(ObjectType type) const
 {
-    return position_;
+    size_t begin = 0;
+    for (size_t t = 0; t < static_cast<size_t>(type); ++t)
+    {
+        begin += counts_[t];
+    }
+    return begin;
 }
 
-const Position& Cell::position() const
+// Back to few enough objects to keep inline, called with size_ already updated
+void Cell::leaveOverflow()
 {
-    return position_;
+    std::vector<GameObjectInterface*>* overflow = overflow_;
+    std::copy(overflow->begin(), overflow->end(), inline_objects_.begin());
+    delete overflow;
 }
 
-void Cell::addObject(std::shared_ptr<GameObjectInterface> object)
+void Cell::addObject(GameObjectInterface* object)
 {
     if (object)
     {
-        objects_[object->type()].push_back(object);
+        ObjectType type = object->type();
+        size_t at = typeBegin(type) + counts_[static_cast<size_t>(type)]; // Last of its type
+
+        if (size_ < kInlineCapacity)
+        {
+            std::copy_backward(inline_objects_.begin() + at, inline_objects_.begin() + size_, inline_objects_.begin() + size_ + 1);
+            inline_objects_[at] = object;
+        }
+        else
+        {
+            if (!overflowing())
+            {
+                // Too many objects to keep inline, move them all to the overflow storage
+                auto* overflow = new std::vector<GameObjectInterface*>(inline_objects_.begin(), inline_objects_.end());
+                overflow->reserve(2 * kInlineCapacity);
+                overflow_ = overflow;
+            }
+            overflow_->insert(overflow_->begin() + at, object);
+        }
+
+        ++size_;
+        ++counts_[static_cast<size_t>(type)];
+        occupancy_ |= typeBit(type);
     }
 }
 
-void Cell::removeObject(std::shared_ptr<GameObjectInterface> object)
+void Cell::removeObject(GameObjectInterface* object)
 {
     if (object)
     {
-        auto it = objects_.find(object->type());
-        if (it != objects_.end())
+        ObjectType type = object->type();
+        size_t begin = typeBegin(type);
+        size_t end = begin + counts_[static_cast<size_t>(type)];
+
+        GameObjectInterface** objects = data();
+        auto obj_it = std::find(objects + begin, objects + end, object);
+        if (obj_it != objects + end)
         {
-            auto& vec = it->second;
-            auto obj_it = std::find(vec.begin(), vec.end(), object);
-            if (obj_it != vec.end())
+            if (!overflowing())
             {
-                vec.erase(obj_it);
-                if (vec.empty())
-                {
-                    objects_.erase(it);
-                }
+                std::copy(obj_it + 1, objects + size_, obj_it);
+                --size_;
+            }
+            else
+            {
+                overflow_->erase(overflow_->begin() + (obj_it - objects));
+                if (--size_ <= kInlineCapacity)
+                    leaveOverflow();
+            }
+
+            if (--counts_[static_cast<size_t>(type)] == 0)
+            {
+                occupancy_ &= ~typeBit(type);
             }
         }
     }
@@ -53,47 +119,45 @@ void Cell::removeObject(std::shared_ptr<GameObjectInterface> object)
 // Remove all objects of the specified type, can be usable sometimes
 void Cell::removeObjectsByType(ObjectType type)
 {
-    objects_.erase(type);
-}
+    size_t begin = typeBegin(type);
+    size_t count = counts_[static_cast<size_t>(type)];
+    if (count == 0)
+        return;
 
-// Return the first object of the specified type, don't use unless you know what you're doing
-std::shared_ptr<GameObjectInterface> Cell::getObjectByType(ObjectType type) const
-{
-    auto it = objects_.find(type);
-    if (it != objects_.end() && !it->second.empty())
+    if (!overflowing())
     {
-        return it->second[0];
+        std::copy(inline_objects_.begin() + begin + count, inline_objects_.begin() + size_, inline_objects_.begin() + begin);
+        size_ -= count;
+    }
+    else
+    {
+        overflow_->erase(overflow_->begin() + begin, overflow_->begin() + begin + count);
+        size_ -= count;
+        if (size_ <= kInlineCapacity)
+            leaveOverflow();
     }
-    return nullptr;
-}
 
-bool Cell::has(ObjectType type) const
-{
-    return objects_.find(type) != objects_.end();
+    counts_[static_cast<size_t>(type)] = 0;
+    occupancy_ &= ~typeBit(type);
 }
 
-bool Cell::empty() const
+void Cell::clear()
 {
-    return objects_.empty();
+    if (overflowing())
+        delete overflow_;
+
+    size_ = 0;
+    counts_ = {};
+    occupancy_ = 0;
 }
 
-const std::vector<std::shared_ptr<GameObjectInterface>>& Cell::getObjectsByType(ObjectType type) const
+// Return the first object of the specified type, don't use unless you know what you're doing
+GameObjectInterface* Cell::getObjectByType(ObjectType type) const
 {
-    static const std::vector<std::shared_ptr<GameObjectInterface>> empty_vector;
-    auto it = objects_.find(type);
-    if (it != objects_.end())
-    {
-        return it->second;
-    }
-    return empty_vector; // Return an empty vector if the type is not found
+    return counts_[static_cast<size_t>(type)] == 0 ? nullptr : data()[typeBegin(type)];
 }
 
-size_t Cell::getObjectsCount() const
+std::span<GameObjectInterface* const> Cell::getObjectsByType(ObjectType type) const
 {
-    size_t count = 0;
-    for (const auto& [type, objects] : objects_)
-    {
-        count += objects.size();
-    }
-    return count;
-}
\ No newline at end of file
+    return {data() + typeBegin(type), counts_[static_cast<size_t>(type)]};
+}
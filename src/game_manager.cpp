@@ -1,6 +1,7 @@
 #include "game_manager.h"
 
 #include <algorithm>
+#include <filesystem>
 #include <iostream>
 
 #include "Player.h"
@@ -11,8 +12,8 @@
 #include "tank.h"
 
 
-GameManager::GameManager(const PlayerFactory& playerFactory, const TankAlgorithmFactory& algorithmFactory)
-    : board_(std::make_unique<Board>(playerFactory, algorithmFactory)) {}
+GameManager::GameManager(const PlayerFactory& playerFactory, const TankAlgorithmFactory& algorithmFactory, GameOptions options)
+    : options_(options), board_(std::make_unique<Board>(playerFactory, algorithmFactory)) {}
 
 std::pair<std::string, std::string> GameManager::splitFilename(const std::string& filename)
 {
@@ -35,7 +36,7 @@ std::pair<std::string, std::string> GameManager::splitFilename(const std::string
     return std::make_pair(directory, name);
 }
 
-std::string GameManager::generateResultMessage() const
+GameResult GameManager::generateResult() const
 {
     std::unordered_map<int, int> alive_counts;
 
@@ -54,7 +55,10 @@ std::string GameManager::generateResultMessage() const
         players_alive.emplace_back(player_id, count);
     }
 
-    std::string summary;
+    GameResult result;
+    result.rounds = (half_steps_count_ + 1) / 2; // The game always ends on a shells-only (odd) half step
+    result.timeouts = algorithm_runner_.timeouts();
+    std::string& summary = result.message;
 
     if (players_alive.empty())
     {
@@ -62,6 +66,7 @@ std::string GameManager::generateResultMessage() const
     }
     else if (players_alive.size() == 1)
     {
+        result.winner = players_alive[0].first;
         summary = "Player " + std::to_string(players_alive[0].first) + " won with " + std::to_string(players_alive[0].second) +
                   " tanks still alive";
     }
@@ -84,7 +89,7 @@ std::string GameManager::generateResultMessage() const
         }
     }
 
-    return summary;
+    return result;
 }
 
 bool GameManager::readBoard(const std::string& filename)
@@ -98,16 +103,53 @@ bool GameManager::readBoard(const std::string& filename)
 
     total_max_steps_ = game_info.max_steps;
     ordered_tanks_ = game_info.ordered_tanks;
+    algorithm_runner_ = AlgorithmRunner(ordered_tanks_.size(), options_.action_time_budget, options_.game_time_budget,
+                                        options_.action_threads, &profiler_);
 
     auto [directory, input_filename] = splitFilename(filename);
     std::string output_filename = directory + static_cast<std::string>(config::get<std::string_view>("output_file_prefix")) + input_filename;
 
-    logger_ = OutputLogger(output_filename, ordered_tanks_.size());
+    if (options_.write_output)
+    {
+        logger_ = OutputLogger(output_filename, ordered_tanks_.size());
+
+        if (!logger_.is_valid())
+        {
+            std::cerr << "Logger is invalid!\n";
+            return false;
+        }
+    }
 
-    if (!logger_.is_valid())
+    if (options_.record_replay)
     {
-        std::cerr << "Logger is invalid!\n";
-        return false;
+        ReplayHeader header;
+        header.board_hash = ReplayWriter::hashBoard(board_->getGrid());
+        header.width = static_cast<uint32_t>(game_info.width);
+        header.height = static_cast<uint32_t>(game_info.height);
+        header.max_steps = static_cast<uint32_t>(game_info.max_steps);
+        header.num_shells = static_cast<uint32_t>(game_info.num_shells);
+        header.max_steps_after_tie = static_cast<uint32_t>(config::get<int>("max_steps_after_tie"));
+        for (const auto& tank : ordered_tanks_)
+        {
+            header.tanks.emplace_back(static_cast<uint8_t>(tank->playerId()), static_cast<uint32_t>(tank->tankId()));
+        }
+
+        // Same name as the output file, so it's skipped as a board the same way
+        std::string replay_filename = std::filesystem::path(output_filename).replace_extension(".replay").string();
+        replay_ = ReplayWriter(replay_filename, header);
+    }
+
+    if constexpr (PhaseProfiler::kEnabled)
+    {
+        std::vector<std::pair<int, int>> tanks;
+        for (const auto& tank : ordered_tanks_)
+        {
+            tanks.emplace_back(tank->playerId(), tank->tankId());
+        }
+        profiler_.setTanks(std::move(tanks));
+
+        std::string extension = config::get<std::string_view>("profile_format") == "csv" ? ".profile.csv" : ".profile.json";
+        profile_filename_ = std::filesystem::path(output_filename).replace_extension(extension).string();
     }
 
     return true;
@@ -127,14 +169,30 @@ void GameManager::logTankActions()
     {
         bool died_this_round = was_alive_at_round_start_[i] && !is_alive_at_end[i];
         logger_.logAction(i, actions_to_execute_[i], actions_validity_[i],
-                          was_alive_at_round_start_[i], died_this_round);
+                          was_alive_at_round_start_[i], died_this_round, actions_timed_out_[i]);
+        replay_.logAction(actions_to_execute_[i], actions_validity_[i], was_alive_at_round_start_[i], died_this_round,
+                          actions_timed_out_[i]);
+    }
+
+    if (round_listener_)
+    {
+        round_actions_.clear();
+        for (size_t i = 0; i < ordered_tanks_.size(); ++i)
+        {
+            round_actions_.push_back(ReplayAction{actions_to_execute_[i], actions_validity_[i], was_alive_at_round_start_[i],
+                                                  was_alive_at_round_start_[i] && !is_alive_at_end[i], actions_timed_out_[i]});
+        }
+        round_listener_(half_steps_count_ / 2, round_actions_);
     }
 }
 
 void GameManager::run()
 {
-    std::cout << "[GameManager] Starting game with the board:" << std::endl;
-    board_->print();
+    if (!options_.headless)
+    {
+        std::cout << "[GameManager] Starting game with the board:" << std::endl;
+        board_->print();
+    }
 
     was_alive_at_round_start_.reserve(ordered_tanks_.size());
     for (const auto& tank : ordered_tanks_)
@@ -146,7 +204,8 @@ void GameManager::run()
     {
         if (half_steps_count_ % 2 == 0)
         {
-            std::cout << "[GameManager] Do tanks and shells step, half_steps_count = " << half_steps_count_ << std::endl;
+            if (!options_.headless)
+                std::cout << "[GameManager] Do tanks and shells step, half_steps_count = " << half_steps_count_ << std::endl;
 
             for (size_t i = 0; i < ordered_tanks_.size(); ++i)
             {
@@ -154,20 +213,31 @@ void GameManager::run()
             }
 
             doTanksStep();
-            board_->print();
-            
-            board_->doShellsStep(false);
-            board_->print();
+            if (!options_.headless)
+                board_->print();
+
+            profiler_.time(GamePhase::ShellsStep, [this]
+                           { board_->doShellsStep(false); });
+            if (!options_.headless)
+                board_->print();
         }
         else
         {
-            std::cout << "[GameManager] Do shells step, half_steps_count = " << half_steps_count_ << std::endl;
-            
-            board_->doShellsStep(true);
+            if (!options_.headless)
+                std::cout << "[GameManager] Do shells step, half_steps_count = " << half_steps_count_ << std::endl;
+
+            profiler_.time(GamePhase::ShellsStep, [this]
+                           { board_->doShellsStep(true); });
+
+            profiler_.time(GamePhase::Logging, [this]
+                           { logTankActions(); });
 
-            logTankActions();
+            if constexpr (config::get<bool>("verbose_debug"))
+                std::cout << "[GameManager] Round " << (half_steps_count_ + 1) / 2 << " board hash "
+                          << std::hex << board_->hash() << std::dec << std::endl;
 
-            board_->print();
+            if (!options_.headless)
+                board_->print();
 
             if (isGameOver())
             {
@@ -177,42 +247,81 @@ void GameManager::run()
         half_steps_count_++;
     }
 
-    logger_.logResult(generateResultMessage());
+    result_ = generateResult();
+    logger_.logResult(std::string(result_.message));
+    replay_.logResult(result_.message);
+
+    if constexpr (PhaseProfiler::kEnabled)
+    {
+        if (options_.write_output)
+            profiler_.writeToFile(profile_filename_);
+    }
 }
 
-void GameManager::getTanksActions()
+const GameResult& GameManager::result() const
 {
-    std::vector<std::optional<ActionRequest>> actions_to_execute;
-    actions_to_execute.reserve(ordered_tanks_.size());
+    return result_;
+}
 
-    // Get actions from all algorithms
-    for (const auto& tank : ordered_tanks_)
+void GameManager::setRoundListener(RoundListener listener)
+{
+    round_listener_ = std::move(listener);
+}
+
+const Board& GameManager::board() const
+{
+    return *board_;
+}
+
+const std::vector<std::shared_ptr<Tank>>& GameManager::tanks() const
+{
+    return ordered_tanks_;
+}
+
+void GameManager::getTanksActions()
+{
+    // The algorithms of the alive tanks, handed over together so they can choose in parallel
+    round_algorithms_.assign(ordered_tanks_.size(), nullptr);
+    for (size_t i = 0; i < ordered_tanks_.size(); ++i)
     {
+        const auto& tank = ordered_tanks_[i];
         if (!tank->isAlive())
         {
-            actions_to_execute.push_back(std::nullopt);
             continue;
         }
 
-        const auto player_id = tank->playerId();
-        const auto tank_id = tank->tankId();
-        auto algorithm = board_->getAlgorithm(player_id, tank_id);
-        if (!algorithm)
+        round_algorithms_[i] = board_->getAlgorithm(tank->playerId(), tank->tankId());
+        if (!round_algorithms_[i])
+        {
+            std::cerr << "[GameManager] Algorithm not found for player " << tank->playerId() << " with tank " << tank->tankId() << std::endl;
+        }
+    }
+
+    algorithm_runner_.getActions(round_algorithms_, timed_actions_);
+
+    std::vector<std::optional<ActionRequest>> actions_to_execute;
+    actions_to_execute.reserve(ordered_tanks_.size());
+    actions_timed_out_.assign(ordered_tanks_.size(), false);
+
+    for (size_t i = 0; i < ordered_tanks_.size(); ++i)
+    {
+        if (!round_algorithms_[i])
         {
-            std::cerr << "[GameManager] Algorithm not found for player " << player_id << " with tank " << tank_id << std::endl;
             actions_to_execute.push_back(std::nullopt);
             continue;
         }
 
-        ActionRequest action_request = algorithm->getAction();
+        const TimedAction& timed_action = timed_actions_[i];
+        actions_timed_out_[i] = timed_action.timed_out;
 
         if constexpr (config::get<bool>("verbose_debug"))
         {
-            std::cout << "[GameManager] Player " << player_id << " with tank " << tank_id
-                      << " decided to execute action: " << tankActionToString(action_request) << std::endl;
+            std::cout << "[GameManager] Player " << ordered_tanks_[i]->playerId() << " with tank " << ordered_tanks_[i]->tankId()
+                      << " decided to execute action: " << tankActionToString(timed_action.action)
+                      << (timed_action.timed_out ? " (timed out)" : "") << std::endl;
         }
 
-        actions_to_execute.push_back(action_request);
+        actions_to_execute.push_back(timed_action.action);
     }
 
     actions_to_execute_ = std::move(actions_to_execute);
@@ -290,11 +399,14 @@ void GameManager::handleTie()
 
 void GameManager::doTanksStep()
 {
-    getTanksActions();
+    profiler_.time(GamePhase::GetActions, [this]
+                   { getTanksActions(); });
 
-    checkActionsValidity();
+    profiler_.time(GamePhase::ExecuteActions, [this]
+                   { checkActionsValidity(); });
 
-    board_->update();
+    profiler_.time(GamePhase::BoardUpdate, [this]
+                   { board_->update(); });
 
     if (total_max_steps_ > 0)
         --total_max_steps_;
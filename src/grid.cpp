@@ -0,0 +1,28 @@
+#include "grid.h"
+
+
+Grid::Grid(size_t width, size_t height)
+{
+    reset(width, height);
+}
+
+void Grid::reset(size_t width, size_t height)
+{
+    // Cells first, so no cell points to a destroyed object
+    if (width == width_ && height == height_ && cells_.size() == width * height)
+    {
+        for (auto& cell : cells_)
+        {
+            cell.clear();
+        }
+    }
+    else
+    {
+        width_ = width;
+        height_ = height;
+        cells_.clear();
+        cells_.resize(width * height);
+    }
+
+    std::apply([](auto&... pools) { (pools.clear(), ...); }, pools_);
+}
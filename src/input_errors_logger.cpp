@@ -2,6 +2,7 @@
 
 #include <fstream>
 #include <iostream>
+#include <mutex>
 
 #include "global_config.h"
 
@@ -17,13 +18,20 @@ void InputErrorLogger::save_to_file(const std::string& filename) const
         return;
     }
 
-    std::ofstream out(filename);
+    // All the loggers write to the same file, games of a batch may finish loading concurrently
+    static std::mutex file_mutex;
+    static bool file_started = false;
+    std::lock_guard<std::mutex> lock(file_mutex);
+
+    std::ofstream out(filename, file_started ? std::ios::app : std::ios::trunc);
     if (!out.is_open())
     {
         std::cerr << "Warning: Failed to create " << filename << std::endl;
         return;
     }
+    file_started = true;
 
+    out << "Board " << board_file_ << ":" << std::endl;
     for (const auto& error : errors_)
     {
         out << error << std::endl;
@@ -1,16 +1,86 @@
+#include <charconv>
 #include <iostream>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
 
+#include "batch_runner.h"
 #include "game_manager.h"
 
 #include "concrete_player_factory.h"
 #include "concrete_tank_algorithm_factory.h"
 
 
+static void printUsage()
+{
+    std::cerr << "Usage: tanks_game [--headless] [--replay] [--action-threads <num_threads>] <game_board_input_file>" << std::endl;
+    std::cerr << "       tanks_game --batch [--threads <num_threads>] [--action-threads <num_threads>] [--replay] <game_board_file_or_directory>..." << std::endl;
+}
+
+// A thread count, a whole positive number with nothing after it
+static bool parseThreadCount(std::string_view text, size_t& r_count)
+{
+    size_t count = 0;
+    auto [end, error] = std::from_chars(text.data(), text.data() + text.size(), count);
+    if (error != std::errc{} || end != text.data() + text.size() || count == 0)
+    {
+        return false;
+    }
+
+    r_count = count;
+    return true;
+}
+
 int main(int argc, char* argv[])
 {
-    if (argc != 2)
+    GameOptions options;
+    bool batch = false;
+    size_t num_threads = std::thread::hardware_concurrency();
+    std::vector<std::string> paths;
+
+    for (int i = 1; i < argc; ++i)
     {
-        std::cerr << "Usage: tanks_game <game_board_input_file>" << std::endl;
+        std::string_view arg = argv[i];
+        if (arg == "--headless")
+        {
+            options.headless = true;
+        }
+        else if (arg == "--replay")
+        {
+            options.record_replay = true;
+        }
+        else if (arg == "--batch")
+        {
+            batch = true;
+        }
+        else if (arg == "--threads" && i + 1 < argc)
+        {
+            if (!parseThreadCount(argv[++i], num_threads))
+            {
+                std::cerr << "Invalid number of threads: " << argv[i] << std::endl;
+                printUsage();
+                return 1;
+            }
+        }
+        else if (arg == "--action-threads" && i + 1 < argc)
+        {
+            if (!parseThreadCount(argv[++i], options.action_threads))
+            {
+                std::cerr << "Invalid number of action threads: " << argv[i] << std::endl;
+                printUsage();
+                return 1;
+            }
+        }
+        else
+        {
+            paths.emplace_back(arg);
+        }
+    }
+
+    if (paths.empty() || (!batch && paths.size() != 1))
+    {
+        printUsage();
         return 1;
     }
 
@@ -18,8 +88,17 @@ int main(int argc, char* argv[])
     {
         auto player_factory = ConcretePlayerFactory();
         auto algorithm_factory = ConcreteTankAlgorithmFactory();
-        GameManager game{player_factory, algorithm_factory};
-        game.readBoard(argv[1]);
+
+        if (batch)
+        {
+            BatchRunner runner{player_factory, algorithm_factory, num_threads, options.record_replay, options.action_threads};
+            BatchSummary summary = runner.run(BatchRunner::collectBoardFiles(paths));
+            summary.print(std::cout);
+            return 0;
+        }
+
+        GameManager game{player_factory, algorithm_factory, options};
+        game.readBoard(paths.front());
         game.run();
     }
     catch (const std::exception& exc)
@@ -0,0 +1,47 @@
+#include "mapped_file.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+
+MappedFile::MappedFile(const std::string& filename)
+{
+    int fd = ::open(filename.c_str(), O_RDONLY);
+    if (fd < 0)
+    {
+        return;
+    }
+
+    struct stat file_stat;
+    if (::fstat(fd, &file_stat) == 0 && S_ISREG(file_stat.st_mode))
+    {
+        size_ = static_cast<size_t>(file_stat.st_size);
+        if (size_ == 0)
+        {
+            valid_ = true; // Nothing to map
+        }
+        else if (void* mapping = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0); mapping != MAP_FAILED)
+        {
+            ::madvise(mapping, size_, MADV_SEQUENTIAL); // Read front to back once
+            data_ = static_cast<const char*>(mapping);
+            valid_ = true;
+        }
+        else
+        {
+            size_ = 0;
+        }
+    }
+
+    // The mapping stays valid after the descriptor is closed
+    ::close(fd);
+}
+
+MappedFile::~MappedFile()
+{
+    if (data_)
+    {
+        ::munmap(const_cast<char*>(data_), size_);
+    }
+}
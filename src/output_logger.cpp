@@ -1,7 +1,12 @@
 #include "output_logger.h"
 
+#include <utility>
 
-OutputLogger::OutputLogger(const std::string& filename, const size_t total_tanks) : out_(filename), total_tanks_(total_tanks)
+#include "global_config.h"
+
+
+OutputLogger::OutputLogger(const std::string& filename, const size_t total_tanks)
+    : out_(filename), total_tanks_(total_tanks), flush_rounds_(config::get<size_t>("output_flush_rounds"))
 {
     if (!out_)
     {
@@ -12,7 +17,36 @@ OutputLogger::OutputLogger(const std::string& filename, const size_t total_tanks
     else
     {
         valid_ = true;
+        buffer_.reserve(kBufferSize);
+    }
+}
+
+OutputLogger::~OutputLogger()
+{
+    writeBuffer(true);
+}
+
+OutputLogger::OutputLogger(OutputLogger&& other) noexcept
+    : out_(std::move(other.out_)),
+      buffer_(std::exchange(other.buffer_, {})),
+      total_tanks_(other.total_tanks_),
+      flush_rounds_(other.flush_rounds_),
+      rounds_since_flush_(other.rounds_since_flush_),
+      valid_(std::exchange(other.valid_, false)) {}
+
+OutputLogger& OutputLogger::operator=(OutputLogger&& other) noexcept
+{
+    if (this != &other)
+    {
+        writeBuffer(true); // Whatever this logger still holds belongs to its own file
+        out_ = std::move(other.out_);
+        buffer_ = std::exchange(other.buffer_, {});
+        total_tanks_ = other.total_tanks_;
+        flush_rounds_ = other.flush_rounds_;
+        rounds_since_flush_ = other.rounds_since_flush_;
+        valid_ = std::exchange(other.valid_, false);
     }
+    return *this;
 }
 
 bool OutputLogger::is_valid() const
@@ -20,64 +54,107 @@ bool OutputLogger::is_valid() const
     return valid_;
 }
 
-void OutputLogger::logAction(size_t tank_no, std::optional<ActionRequest> action, bool valid, bool was_alive_at_start, bool died_this_round)
+void OutputLogger::logAction(size_t tank_no, std::optional<ActionRequest> action, bool valid, bool was_alive_at_start, bool died_this_round,
+                             bool timed_out)
+{
+    if (!valid_)
+    {
+        return;
+    }
+
+    writeAction(buffer_, action, valid, was_alive_at_start, died_this_round, timed_out);
+
+    if (tank_no < total_tanks_ - 1)
+    {
+        buffer_ += ", ";
+        return;
+    }
+
+    // End of the round
+    buffer_ += '\n';
+    if (flush_rounds_ > 0 && ++rounds_since_flush_ == flush_rounds_)
+    {
+        rounds_since_flush_ = 0;
+        writeBuffer(true);
+    }
+    else if (buffer_.size() >= kBufferSize)
+    {
+        writeBuffer(false);
+    }
+}
+
+void OutputLogger::logResult(std::string&& result)
+{
+    if (!valid_)
+    {
+        return;
+    }
+
+    buffer_ += result;
+    buffer_ += '\n';
+    writeBuffer(true);
+}
+
+// Hands the buffer to the file, the buffer keeps its memory for the next rounds
+void OutputLogger::writeBuffer(bool flush)
 {
     if (!valid_)
     {
         return;
     }
 
+    if (!buffer_.empty())
+    {
+        out_.write(buffer_.data(), static_cast<std::streamsize>(buffer_.size()));
+        buffer_.clear();
+    }
+    if (flush)
+    {
+        out_.flush();
+    }
+}
+
+void OutputLogger::writeAction(std::string& out, std::optional<ActionRequest> action, bool valid, bool was_alive_at_start, bool died_this_round,
+                               bool timed_out)
+{
     if (!was_alive_at_start)
     {
         // Tank was already dead before this round started
-        out_ << "killed";
+        out += "killed";
     }
     else
     {
         // Tank was alive at start, so show its action
         if (action)
         {
-            out_ << action_to_string(*action);
+            out += action_to_string(*action);
         }
         else
         {
-            out_ << "DoNothing"; // Fallback, though this shouldn't happen for alive tanks
+            out += "DoNothing"; // Fallback, though this shouldn't happen for alive tanks
+        }
+
+        // Add (timed out) if the algorithm ran out of time and the tank did nothing instead
+        if (timed_out)
+        {
+            out += " (timed out)";
         }
 
         // Add (ignored) if action was invalid
         if (!valid)
         {
-            out_ << " (ignored)";
+            out += " (ignored)";
         }
 
         // Add (killed) if tank died during this round
         if (died_this_round)
         {
-            out_ << " (killed)";
+            out += " (killed)";
         }
     }
-
-    if (tank_no < total_tanks_ - 1)
-    {
-        out_ << ", ";
-    }
-    else
-    {
-        out_ << std::endl;
-    }
-}
-
-void OutputLogger::logResult(std::string&& result)
-{
-    if (!valid_)
-    {
-        return;
-    }
-
-    out_ << std::move(result) << std::endl;
 }
 
-std::string OutputLogger::action_to_string(ActionRequest action) const
+std::string_view OutputLogger::action_to_string(ActionRequest action)
 {
     switch (action)
     {
@@ -0,0 +1,182 @@
+#include "phase_profiler.h"
+
+#include <algorithm>
+#include <bit>
+#include <fstream>
+#include <iostream>
+#include <map>
+
+
+std::string_view gamePhaseName(GamePhase phase)
+{
+    switch (phase)
+    {
+    case GamePhase::GetActions:
+        return "get_actions";
+    case GamePhase::ExecuteActions:
+        return "execute_actions";
+    case GamePhase::BoardUpdate:
+        return "board_update";
+    case GamePhase::ShellsStep:
+        return "shells_step";
+    case GamePhase::Logging:
+        return "logging";
+    default:
+        return "unknown";
+    }
+}
+
+void TimingHistogram::add(uint64_t ns)
+{
+    size_t bucket = ns == 0 ? 0 : static_cast<size_t>(std::bit_width(ns)) - 1;
+    ++buckets_[bucket];
+    ++count_;
+    total_ns_ += ns;
+    min_ns_ = std::min(min_ns_, ns);
+    max_ns_ = std::max(max_ns_, ns);
+}
+
+void TimingHistogram::merge(const TimingHistogram& other)
+{
+    for (size_t i = 0; i < kBuckets; ++i)
+    {
+        buckets_[i] += other.buckets_[i];
+    }
+    count_ += other.count_;
+    total_ns_ += other.total_ns_;
+    min_ns_ = std::min(min_ns_, other.min_ns_);
+    max_ns_ = std::max(max_ns_, other.max_ns_);
+}
+
+void PhaseProfiler::setTanks(std::vector<std::pair<int, int>> tanks)
+{
+    tanks_ = std::move(tanks);
+    algorithms_.assign(tanks_.size(), TimingHistogram{});
+}
+
+void PhaseProfiler::record(GamePhase phase, uint64_t ns)
+{
+    phases_[static_cast<size_t>(phase)].add(ns);
+}
+
+void PhaseProfiler::recordAlgorithm(size_t tank_no, uint64_t ns)
+{
+    if (tank_no < algorithms_.size())
+    {
+        algorithms_[tank_no].add(ns);
+    }
+}
+
+std::vector<std::pair<int, TimingHistogram>> PhaseProfiler::playerHistograms() const
+{
+    std::map<int, TimingHistogram> players;
+    for (size_t i = 0; i < tanks_.size(); ++i)
+    {
+        players[tanks_[i].first].merge(algorithms_[i]);
+    }
+    return {players.begin(), players.end()};
+}
+
+// The summary fields of a histogram, and its non-empty buckets as [lower bound ns, count] pairs
+static void writeJsonHistogram(std::ostream& out, const TimingHistogram& histogram)
+{
+    out << "\"count\": " << histogram.count() << ", \"total_ns\": " << histogram.totalNs() << ", \"min_ns\": " << histogram.minNs()
+        << ", \"max_ns\": " << histogram.maxNs() << ", \"buckets\": [";
+
+    bool first = true;
+    for (size_t i = 0; i < TimingHistogram::kBuckets; ++i)
+    {
+        if (histogram.buckets()[i] == 0)
+        {
+            continue;
+        }
+        out << (first ? "" : ", ") << '[' << (i == 0 ? 0 : uint64_t{1} << i) << ", " << histogram.buckets()[i] << ']';
+        first = false;
+    }
+    out << ']';
+}
+
+void PhaseProfiler::writeJson(std::ostream& out) const
+{
+    out << "{\n  \"phases\": [\n";
+    for (size_t i = 0; i < phases_.size(); ++i)
+    {
+        out << "    {\"phase\": \"" << gamePhaseName(static_cast<GamePhase>(i)) << "\", ";
+        writeJsonHistogram(out, phases_[i]);
+        out << (i + 1 < phases_.size() ? "},\n" : "}\n");
+    }
+
+    out << "  ],\n  \"players\": [\n";
+    auto players = playerHistograms();
+    for (size_t i = 0; i < players.size(); ++i)
+    {
+        out << "    {\"player\": " << players[i].first << ", ";
+        writeJsonHistogram(out, players[i].second);
+        out << (i + 1 < players.size() ? "},\n" : "}\n");
+    }
+
+    out << "  ],\n  \"tanks\": [\n";
+    for (size_t i = 0; i < tanks_.size(); ++i)
+    {
+        out << "    {\"player\": " << tanks_[i].first << ", \"tank\": " << tanks_[i].second << ", ";
+        writeJsonHistogram(out, algorithms_[i]);
+        out << (i + 1 < tanks_.size() ? "},\n" : "}\n");
+    }
+    out << "  ]\n}\n";
+}
+
+// A row per histogram, the non-empty buckets in the last column as lower bound ns:count pairs
+static void writeCsvRow(std::ostream& out, std::string_view scope, std::string_view name, const TimingHistogram& histogram)
+{
+    out << scope << ',' << name << ',' << histogram.count() << ',' << histogram.totalNs() << ',' << histogram.minNs() << ','
+        << histogram.maxNs() << ',';
+
+    bool first = true;
+    for (size_t i = 0; i < TimingHistogram::kBuckets; ++i)
+    {
+        if (histogram.buckets()[i] == 0)
+        {
+            continue;
+        }
+        out << (first ? "" : ";") << (i == 0 ? 0 : uint64_t{1} << i) << ':' << histogram.buckets()[i];
+        first = false;
+    }
+    out << '\n';
+}
+
+void PhaseProfiler::writeCsv(std::ostream& out) const
+{
+    out << "scope,name,count,total_ns,min_ns,max_ns,buckets\n";
+    for (size_t i = 0; i < phases_.size(); ++i)
+    {
+        writeCsvRow(out, "phase", gamePhaseName(static_cast<GamePhase>(i)), phases_[i]);
+    }
+    for (const auto& [player_id, histogram] : playerHistograms())
+    {
+        writeCsvRow(out, "player", std::to_string(player_id), histogram);
+    }
+    for (size_t i = 0; i < tanks_.size(); ++i)
+    {
+        writeCsvRow(out, "tank", std::to_string(tanks_[i].first) + ":" + std::to_string(tanks_[i].second), algorithms_[i]);
+    }
+}
+
+bool PhaseProfiler::writeToFile(const std::string& filename) const
+{
+    std::ofstream out(filename);
+    if (!out)
+    {
+        std::cerr << "Warning: Failed to open profile file: " << filename << std::endl;
+        return false;
+    }
+
+    if (config::get<std::string_view>("profile_format") == "csv")
+    {
+        writeCsv(out);
+    }
+    else
+    {
+        writeJson(out);
+    }
+    return static_cast<bool>(out);
+}
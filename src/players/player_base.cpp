@@ -1,5 +1,8 @@
 #include "player_base.h"
 
+#include <algorithm>
+#include <utility>
+
 #include "algorithm_utils.h"
 #include "global_config.h"
 
@@ -8,65 +11,63 @@ PlayerBase::PlayerBase(int player_index, size_t x, size_t y, size_t max_steps, s
     : Player(player_index, x, y, max_steps, num_shells),
       player_index_(player_index), width_(x), height_(y), max_steps_(max_steps), num_shells_(num_shells) {}
 
-void PlayerBase::setShellsAsNew(const std::vector<std::vector<Cell>>& grid)
+void PlayerBase::setShellsAsNew(const Grid& grid)
 {
-    const auto& all_directions = getAllDirections();
     for (size_t x = 0; x < width_; ++x)
     {
         for (size_t y = 0; y < height_; ++y)
         {
             Position curr_pos{x, y};
-            if (!grid[x][y].has(ObjectType::Shell))
+            if (!grid.at(x, y).has(ObjectType::Shell))
                 continue;
-            shell_possible_directions_[curr_pos] = std::unordered_set<Direction>(all_directions.begin(), all_directions.end());
+            shell_possible_directions_.set(curr_pos, DirectionSet::all());
         }
     }
 }
 
-// Derives all possible directions for shells based on the previous and current grid states.
-void PlayerBase::updateShellPossibleDirections(const std::vector<std::vector<Cell>>& prev_grid,
-                                               const std::vector<std::vector<Cell>>& curr_grid)
+// Derives all possible directions for shells based on the previous snapshot and the current grid state.
+void PlayerBase::updateShellPossibleDirections(const SatelliteSnapshot& prev_snapshot, const Grid& curr_grid)
 {
-    // Save previous possible directions for narrowing down the possible directions
-    auto prev_shell_possible_directions = shell_possible_directions_;
+    size_t interval = config::get<size_t>("battle_info_interval"); // Maximum number of turns passed since the last GetBattleInfo request
+
+    // Uses the previous possible directions for narrowing down the possible directions
+    computeShellDirectionMasks(prev_snapshot, curr_grid, interval);
     shell_possible_directions_.clear();
     possible_turns_passed_.clear();
 
-    size_t interval = config::get<size_t>("battle_info_interval"); // Maximum number of turns passed since the last GetBattleInfo request
-    size_t num_shells = getNumberOfShellsInGrid(curr_grid);
+    size_t num_shells = shells_.size();
 
     // Try to find possible directions for as many shells as possible, when the number of unexplainable shells is from 0 to num_shells
     for (size_t max_unexplainable = 0; max_unexplainable <= num_shells; ++max_unexplainable)
     {
-        bool found_valid = false;
-
         // For each shell, accumulate possible directions for all valid number of turns passed
-        std::unordered_map<Position, std::unordered_set<Direction>> accumulated_directions;
+        std::vector<DirectionSet> accumulated_masks(num_shells);
+        bool found_valid = false;
 
         // Try to find valid number of turns passed that match all shells' movements
         for (size_t turns_passed = 0; turns_passed <= interval; ++turns_passed)
         {
-            std::unordered_map<Position, std::unordered_set<Direction>> candidate_map;
-            std::vector<Position> unexplainable_shells;
-
-            getShellPossibleDirectionsForTurnsPassed(
-                prev_grid, curr_grid, prev_shell_possible_directions, turns_passed,
-                candidate_map, unexplainable_shells);
+            if (unexplainable_counts_[turns_passed] > max_unexplainable)
+                continue;
 
-            if (unexplainable_shells.size() <= max_unexplainable)
+            // If we have less unexplainable shells than allowed, we can consider this a valid number of turns passed
+            // and accumulate possible directions for each shell, unexplainable shells are treated as new with all directions possible
+            found_valid = true;
+            possible_turns_passed_.insert(turns_passed);
+            const DirectionSet* masks = turns_masks_.data() + turns_passed * num_shells;
+            for (size_t shell = 0; shell < num_shells; ++shell)
             {
-                // If we have less unexplainable shells than allowed, we can consider this a valid number of turns passed
-                // and accumulate possible directions for each shell
-                found_valid = true;
-                possible_turns_passed_.insert(turns_passed);
-                accumulateDirections(accumulated_directions, candidate_map, unexplainable_shells);
+                accumulated_masks[shell] |= masks[shell].empty() ? DirectionSet::all() : masks[shell];
             }
         }
 
         if (found_valid)
         {
             // Found valid possible directions with as few unexplainable shells as possible
-            shell_possible_directions_ = std::move(accumulated_directions);
+            for (size_t shell = 0; shell < num_shells; ++shell)
+            {
+                shell_possible_directions_.set(shells_[shell], accumulated_masks[shell]);
+            }
             return;
         }
     }
@@ -76,87 +77,86 @@ void PlayerBase::updateShellPossibleDirections(const std::vector<std::vector<Cel
     setShellsAsNew(curr_grid);
 }
 
-void PlayerBase::accumulateDirections(std::unordered_map<Position, std::unordered_set<Direction>>& accumulated_directions,
-                                      std::unordered_map<Position, std::unordered_set<Direction>>& candidate_map,
-                                      const std::vector<Position>& unexplainable_shells)
+// For every number of turns passed, finds the directions each shell could have come from.
+// Every (shell, direction) ray is walked back once for all the turns, stopping at the first wall.
+void PlayerBase::computeShellDirectionMasks(const SatelliteSnapshot& prev_snapshot, const Grid& curr_grid, size_t interval)
 {
-    const auto& all_directions = getAllDirections();
-
-    // For unexplainable shells, treat as new with all directions possible
-    for (const auto& pos : unexplainable_shells)
-    {
-        candidate_map[pos] = std::unordered_set<Direction>(all_directions.begin(), all_directions.end());
-    }
-
-    // Accumulate possible directions for all shells
-    for (const auto& [pos, dirs] : candidate_map)
+    shells_.clear();
+    for (size_t x = 0; x < width_; ++x)
     {
-        accumulated_directions[pos].insert(dirs.begin(), dirs.end());
+        for (size_t y = 0; y < height_; ++y)
+        {
+            if (curr_grid.at(x, y).has(ObjectType::Shell))
+                shells_.emplace_back(x, y);
+        }
     }
-}
 
-void PlayerBase::getShellPossibleDirectionsForTurnsPassed(const std::vector<std::vector<Cell>>& prev_grid,
-                                                          const std::vector<std::vector<Cell>>& curr_grid,
-                                                          const std::unordered_map<Position, std::unordered_set<Direction>>& prev_shell_possible_directions,
-                                                          size_t turns_passed,
-                                                          std::unordered_map<Position, std::unordered_set<Direction>>& candidate_map,
-                                                          std::vector<Position>& unexplainable_shells)
-{
-    const auto& all_directions = getAllDirections();
+    size_t num_shells = shells_.size();
+    turns_masks_.assign((interval + 1) * num_shells, DirectionSet());
+    unexplainable_counts_.assign(interval + 1, 0);
 
-    for (size_t x = 0; x < width_; ++x)
+    // Treat an empty previous snapshot as walls everywhere, nothing could have moved
+    if (prev_snapshot.width() != 0)
     {
-        for (size_t y = 0; y < height_; ++y)
+        // Previous knowledge per cell, a shell we know nothing about could have flown in any direction
+        prev_masks_.assign(curr_grid.size(), DirectionSet::all());
+        for (const auto& [pos, directions] : shell_possible_directions_)
         {
-            Position curr_pos{x, y};
-
-            if (!curr_grid[x][y].has(ObjectType::Shell))
-                continue;
+            prev_masks_[curr_grid.index(pos)] = directions;
+        }
 
-            // For every shell, find all possible directions it could have moved from
-            std::unordered_set<Direction> possible_dirs;
-            for (Direction dir : all_directions)
+        for (size_t shell = 0; shell < num_shells; ++shell)
+        {
+            for (Direction dir : getAllDirections())
             {
-                // Make sure not to count directions blocked by walls
-                // We allow tanks and shells be in the way, because they could have moved in after the shell
-                // and we want this function to catch all possible directions
-                if (isBlockedByWall(prev_grid, curr_pos, dir, 2 * turns_passed))
-                    continue;
-
-                Position prev_pos = backwardPosition(curr_pos, dir, width_, height_, 2 * turns_passed);
-                if (prev_grid[prev_pos.first][prev_pos.second].has(ObjectType::Shell))
+                Position prev_pos = shells_[shell];
+                for (size_t turns_passed = 0; turns_passed <= interval; ++turns_passed)
                 {
-                    // If we have previous knowledge, intersect
-                    auto it = prev_shell_possible_directions.find(prev_pos);
-                    if (it != prev_shell_possible_directions.end())
+                    // Make sure not to count directions blocked by walls
+                    // We allow tanks and shells be in the way, because they could have moved in after the shell
+                    // and we want to catch all possible directions
+                    if (turns_passed > 0)
                     {
-                        if (it->second.count(dir))
-                            possible_dirs.insert(dir);
+                        if (isBlockedByWall(prev_snapshot, prev_pos, dir, 2))
+                            break; // Blocked for all the following turns as well
+
+                        prev_pos = backwardPosition(prev_pos, dir, width_, height_, 2);
                     }
-                    else
+
+                    size_t prev_index = curr_grid.index(prev_pos); // Same board, same layout
+                    if (prev_snapshot.data()[prev_index] == '*' && prev_masks_[prev_index].contains(dir))
                     {
-                        // Shouldn't happen, because we should know all shells from prev_grid
-                        possible_dirs.insert(dir);
+                        turns_masks_[turns_passed * num_shells + shell].insert(dir);
                     }
                 }
             }
-            if (possible_dirs.empty())
-            {
-                unexplainable_shells.push_back(curr_pos);
-            }
-            candidate_map[curr_pos] = std::move(possible_dirs); // If is empty, will fill with all directions if allowed
         }
     }
+
+    for (size_t turns_passed = 0; turns_passed <= interval; ++turns_passed)
+    {
+        const DirectionSet* masks = turns_masks_.data() + turns_passed * num_shells;
+        unexplainable_counts_[turns_passed] = std::count(masks, masks + num_shells, DirectionSet());
+    }
 }
 
 SmartBattleInfo PlayerBase::createBattleInfo(const SatelliteView& satellite_view)
 {
     Position tank_position;
-    auto prev_grid = grid_;
-    grid_ = reconstructGridFromSatelliteView(satellite_view, height_, width_, player_index_, num_shells_, tank_position);
+    // The view is read once, the player and the tank both work from the same snapshot
+    // The previous view is kept for the shells, and the one before it is refilled unless a tank still holds on to it
+    std::swap(prev_snapshot_, snapshot_);
+    if (!snapshot_ || snapshot_.use_count() > 1)
+    {
+        snapshot_ = std::make_shared<SatelliteSnapshot>();
+    }
+    captureSatelliteView(satellite_view, width_, height_, *snapshot_);
+
+    changed_cells_.clear();
+    refreshGridFromSnapshot(grid_, *snapshot_, player_index_, num_shells_, tank_position, changed_cells_);
 
     // Update shell directions before constructing info
-    updateShellPossibleDirections(prev_grid, grid_);
+    updateShellPossibleDirections(prev_snapshot_ ? *prev_snapshot_ : SatelliteSnapshot(), grid_);
 
-    return SmartBattleInfo(satellite_view, height_, width_, max_steps_, num_shells_, shell_possible_directions_);
+    return SmartBattleInfo(snapshot_, height_, width_, max_steps_, num_shells_, shell_possible_directions_);
 }
\ No newline at end of file
@@ -70,7 +70,7 @@ void SmartPlayer::updateWallsDamage()
     for (auto it = reported_shell_wall_hits_.begin(); it != reported_shell_wall_hits_.end();)
     {
         const Position& shell_pos = it->first;
-        if (grid_[shell_pos.first][shell_pos.second].has(ObjectType::Shell))
+        if (grid_[shell_pos].has(ObjectType::Shell))
         {
             ++it; // Shell still exists, keep the hit
         }
@@ -83,7 +83,7 @@ void SmartPlayer::updateWallsDamage()
 
 bool SmartPlayer::isShellCloseToWall(const Position& shell_pos, Direction shell_dir, Position& r_wall_pos) const
 {
-    if (grid_.empty() || grid_[0].empty())
+    if (grid_.empty())
     {
         return false; // If grid is empty, no walls can be close
     }
@@ -94,7 +94,7 @@ bool SmartPlayer::isShellCloseToWall(const Position& shell_pos, Direction shell_
     for (size_t i = 0; i < steps; ++i)
     {
         pos = forwardPosition(pos, shell_dir, width_, height_);
-        const Cell& cell = grid_[pos.first][pos.second];
+        const Cell& cell = grid_[pos];
 
         if (cell.has(ObjectType::Wall))
         {
@@ -107,7 +107,8 @@ bool SmartPlayer::isShellCloseToWall(const Position& shell_pos, Direction shell_
         }
         else if (cell.has(ObjectType::Shell))
         {
-            if (getOrDefault(shell_possible_directions_, pos, std::unordered_set<Direction>()).count(getOppositeDirection(shell_dir)))
+            const DirectionSet* directions = shell_possible_directions_.find(pos);
+            if (directions && directions->contains(getOppositeDirection(shell_dir)))
             {
                 // If there's a shell moving in the opposite direction, it'll hit us and we won't make it to the wall
                 return false;
@@ -0,0 +1,370 @@
+#include "replay.h"
+
+#include <cstring>
+#include <iostream>
+#include <iterator>
+
+#include "board_satellite_view.h"
+#include "output_logger.h"
+
+
+namespace
+{
+
+constexpr char kMagic[4] = {'T', 'N', 'K', 'R'};
+constexpr uint8_t kVersion = 2; // Version 1 had u8 tank ids, still read
+
+// Reads the little-endian numbers of a loaded replay, failing once it runs past the end
+class ByteReader
+{
+public:
+    explicit ByteReader(const std::vector<uint8_t>& data) : data_(data) {}
+
+    bool ok() const { return ok_; }
+    bool atEnd() const { return pos_ >= data_.size(); }
+    uint8_t peek() const { return atEnd() ? 0 : data_[pos_]; }
+
+    uint64_t get(size_t bytes)
+    {
+        if (pos_ + bytes > data_.size())
+        {
+            ok_ = false;
+            return 0;
+        }
+
+        uint64_t value = 0;
+        for (size_t i = 0; i < bytes; ++i)
+        {
+            value |= static_cast<uint64_t>(data_[pos_++]) << (8 * i);
+        }
+        return value;
+    }
+
+    const uint8_t* take(size_t bytes)
+    {
+        if (pos_ + bytes > data_.size())
+        {
+            ok_ = false;
+            return nullptr;
+        }
+
+        const uint8_t* start = data_.data() + pos_;
+        pos_ += bytes;
+        return start;
+    }
+
+private:
+    const std::vector<uint8_t>& data_;
+    size_t pos_ = 0;
+    bool ok_ = true;
+};
+
+} // namespace
+
+uint8_t ReplayAction::pack() const
+{
+    uint8_t byte = action ? static_cast<uint8_t>(*action) : kNoAction;
+    if (valid)
+        byte |= kValidBit;
+    if (alive_at_start)
+        byte |= kAliveBit;
+    if (killed)
+        byte |= kKilledBit;
+    if (timed_out)
+        byte |= kTimedOutBit;
+    return byte;
+}
+
+ReplayAction ReplayAction::unpack(uint8_t byte)
+{
+    ReplayAction replay_action;
+    if ((byte & kNoAction) != kNoAction)
+        replay_action.action = static_cast<ActionRequest>(byte & kNoAction);
+    replay_action.valid = byte & kValidBit;
+    replay_action.alive_at_start = byte & kAliveBit;
+    replay_action.killed = byte & kKilledBit;
+    replay_action.timed_out = byte & kTimedOutBit;
+    return replay_action;
+}
+
+ReplayWriter::ReplayWriter(const std::string& filename, const ReplayHeader& header)
+    : out_(filename, std::ios::binary)
+{
+    if (!out_)
+    {
+        std::cerr << "Warning: Failed to open replay file: " << filename << std::endl;
+        return;
+    }
+
+    valid_ = true;
+    buffer_.reserve(kBufferSize);
+
+    for (char ch : kMagic)
+    {
+        put(static_cast<uint8_t>(ch));
+    }
+    put(kVersion);
+    putU64(header.board_hash);
+    putU32(header.width);
+    putU32(header.height);
+    putU32(header.max_steps);
+    putU32(header.num_shells);
+    putU32(header.max_steps_after_tie);
+    putU32(static_cast<uint32_t>(header.tanks.size()));
+    for (const auto& [player_id, tank_id] : header.tanks)
+    {
+        put(player_id);
+        putU32(tank_id);
+    }
+}
+
+ReplayWriter::~ReplayWriter()
+{
+    flush();
+}
+
+void ReplayWriter::logAction(std::optional<ActionRequest> action, bool valid, bool was_alive_at_start, bool died_this_round, bool timed_out)
+{
+    if (!valid_)
+    {
+        return;
+    }
+
+    put(ReplayAction{action, valid, was_alive_at_start, died_this_round, timed_out}.pack());
+}
+
+void ReplayWriter::logResult(std::string_view result)
+{
+    if (!valid_)
+    {
+        return;
+    }
+
+    put(ReplayAction::kEndOfRounds);
+    putU32(static_cast<uint32_t>(result.size()));
+    for (char ch : result)
+    {
+        put(static_cast<uint8_t>(ch));
+    }
+    flush();
+}
+
+uint64_t ReplayWriter::hashBoard(const Grid& grid)
+{
+    // FNV-1a over the size and the satellite image of the board
+    uint64_t hash = 14695981039346656037ull;
+    auto mix = [&hash](uint64_t byte)
+    {
+        hash ^= byte;
+        hash *= 1099511628211ull;
+    };
+
+    mix(grid.width());
+    mix(grid.height());
+    for (const auto& cell : grid)
+    {
+        mix(static_cast<uint8_t>(BoardSatelliteView::cellToChar(cell)));
+    }
+    return hash;
+}
+
+void ReplayWriter::put(uint8_t byte)
+{
+    buffer_.push_back(byte);
+    if (buffer_.size() == kBufferSize)
+    {
+        flush();
+    }
+}
+
+void ReplayWriter::putU32(uint32_t value)
+{
+    for (size_t i = 0; i < 4; ++i)
+    {
+        put(static_cast<uint8_t>(value >> (8 * i)));
+    }
+}
+
+void ReplayWriter::putU64(uint64_t value)
+{
+    for (size_t i = 0; i < 8; ++i)
+    {
+        put(static_cast<uint8_t>(value >> (8 * i)));
+    }
+}
+
+void ReplayWriter::flush()
+{
+    if (!buffer_.empty() && out_)
+    {
+        out_.write(reinterpret_cast<const char*>(buffer_.data()), static_cast<std::streamsize>(buffer_.size()));
+        out_.flush();
+    }
+    buffer_.clear();
+}
+
+ReplayReader::ReplayReader(const std::string& filename)
+{
+    std::ifstream in(filename, std::ios::binary);
+    if (!in)
+    {
+        std::cerr << "Warning: Failed to open replay file: " << filename << std::endl;
+        return;
+    }
+
+    std::vector<uint8_t> data((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    bool binary = data.size() >= sizeof(kMagic) && std::memcmp(data.data(), kMagic, sizeof(kMagic)) == 0;
+    valid_ = binary ? parse(data) : parseText(data);
+    has_header_ = valid_ && binary;
+    if (!valid_)
+    {
+        std::cerr << "Warning: Replay file is invalid: " << filename << std::endl;
+    }
+}
+
+bool ReplayReader::parse(const std::vector<uint8_t>& data)
+{
+    ByteReader reader(data);
+
+    const uint8_t* magic = reader.take(sizeof(kMagic));
+    if (!magic || std::memcmp(magic, kMagic, sizeof(kMagic)) != 0)
+        return false;
+    uint64_t version = reader.get(1);
+    if (version < 1 || version > kVersion)
+        return false;
+    size_t tank_id_bytes = version == 1 ? 1 : 4;
+
+    header_.board_hash = reader.get(8);
+    header_.width = static_cast<uint32_t>(reader.get(4));
+    header_.height = static_cast<uint32_t>(reader.get(4));
+    header_.max_steps = static_cast<uint32_t>(reader.get(4));
+    header_.num_shells = static_cast<uint32_t>(reader.get(4));
+    header_.max_steps_after_tie = static_cast<uint32_t>(reader.get(4));
+
+    size_t tanks_count = reader.get(4);
+    if (!reader.ok() || tanks_count == 0)
+        return false;
+
+    tanks_count_ = tanks_count;
+    header_.tanks.clear();
+    for (size_t i = 0; i < tanks_count && reader.ok(); ++i)
+    {
+        uint8_t player_id = static_cast<uint8_t>(reader.get(1));
+        uint32_t tank_id = static_cast<uint32_t>(reader.get(tank_id_bytes));
+        header_.tanks.emplace_back(player_id, tank_id);
+    }
+
+    // Rounds until the end marker, which can't be the first byte of a round
+    actions_.clear();
+    while (reader.ok() && !reader.atEnd() && reader.peek() != ReplayAction::kEndOfRounds)
+    {
+        const uint8_t* round = reader.take(tanks_count);
+        if (round)
+            actions_.insert(actions_.end(), round, round + tanks_count);
+    }
+
+    reader.get(1); // The end marker
+    size_t result_length = reader.get(4);
+    const uint8_t* result = reader.take(result_length);
+    if (!reader.ok() || !reader.atEnd())
+        return false;
+
+    result_.assign(reinterpret_cast<const char*>(result), result_length);
+    return true;
+}
+
+bool ReplayReader::parseText(const std::vector<uint8_t>& data)
+{
+    std::string_view text(reinterpret_cast<const char*>(data.data()), data.size());
+
+    std::vector<std::string_view> lines;
+    while (!text.empty())
+    {
+        size_t end = text.find('\n');
+        lines.push_back(text.substr(0, end));
+        text.remove_prefix(end == std::string_view::npos ? text.size() : end + 1);
+    }
+
+    // Round lines, then the result line
+    if (lines.size() < 2)
+        return false;
+
+    header_ = ReplayHeader();
+    tanks_count_ = 0;
+    actions_.clear();
+    for (size_t i = 0; i + 1 < lines.size(); ++i)
+    {
+        size_t tanks_in_round = 0;
+        std::string_view line = lines[i];
+        while (true)
+        {
+            size_t end = line.find(", ");
+            std::string_view token = line.substr(0, end);
+
+            ReplayAction replay_action;
+            if (token != "killed")
+            {
+                replay_action.alive_at_start = true;
+                replay_action.valid = true;
+                if (token.ends_with(" (killed)"))
+                {
+                    replay_action.killed = true;
+                    token.remove_suffix(std::string_view(" (killed)").size());
+                }
+                if (token.ends_with(" (ignored)"))
+                {
+                    replay_action.valid = false;
+                    token.remove_suffix(std::string_view(" (ignored)").size());
+                }
+                if (token.ends_with(" (timed out)"))
+                {
+                    replay_action.timed_out = true;
+                    token.remove_suffix(std::string_view(" (timed out)").size());
+                }
+
+                for (int code = 0; code <= static_cast<int>(ActionRequest::DoNothing); ++code)
+                {
+                    if (OutputLogger::action_to_string(static_cast<ActionRequest>(code)) == token)
+                        replay_action.action = static_cast<ActionRequest>(code);
+                }
+                if (!replay_action.action)
+                    return false;
+            }
+
+            actions_.push_back(replay_action.pack());
+            ++tanks_in_round;
+
+            if (end == std::string_view::npos)
+                break;
+            line.remove_prefix(end + 2);
+        }
+
+        if (tanks_count_ == 0)
+            tanks_count_ = tanks_in_round;
+        else if (tanks_in_round != tanks_count_)
+            return false;
+    }
+
+    result_ = lines.back();
+    return true;
+}
+
+void ReplayReader::writeText(std::ostream& out) const
+{
+    size_t tanks_count = tanks_count_;
+    std::string line;
+    for (size_t round = 0; round < rounds(); ++round)
+    {
+        line.clear();
+        for (size_t tank_no = 0; tank_no < tanks_count; ++tank_no)
+        {
+            ReplayAction replay_action = action(round, tank_no);
+            OutputLogger::writeAction(line, replay_action.action, replay_action.valid, replay_action.alive_at_start,
+                                      replay_action.killed, replay_action.timed_out);
+            line += tank_no < tanks_count - 1 ? ", " : "\n";
+        }
+        out << line;
+    }
+
+    out << result_ << '\n';
+}
@@ -0,0 +1,118 @@
+#include "replay_verifier.h"
+
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "game_manager.h"
+#include "output_logger.h"
+#include "replay_factories.h"
+
+
+// The round flags the replayed game must reproduce. A timeout isn't one, the recorded DoNothing replays on time.
+static bool sameOutcome(const ReplayAction& recorded, const ReplayAction& replayed)
+{
+    if (recorded.alive_at_start != replayed.alive_at_start)
+        return false;
+    if (!recorded.alive_at_start)
+        return true;
+    return recorded.action == replayed.action && recorded.valid == replayed.valid && recorded.killed == replayed.killed;
+}
+
+static std::string describe(const ReplayAction& replay_action)
+{
+    if (!replay_action.alive_at_start)
+        return "dead";
+
+    std::string text(replay_action.action ? OutputLogger::action_to_string(*replay_action.action) : "no action");
+    if (!replay_action.valid)
+        text += " (ignored)";
+    if (replay_action.killed)
+        text += " (killed)";
+    return text;
+}
+
+// Empty if the round played out as recorded
+static std::string roundDivergence(const ReplayReader& recording, size_t round, const std::vector<ReplayAction>& actions)
+{
+    if (round >= recording.rounds())
+    {
+        return "round " + std::to_string(round) + " was played, the recording ends after " + std::to_string(recording.rounds()) + " rounds";
+    }
+    for (size_t tank_no = 0; tank_no < actions.size(); ++tank_no)
+    {
+        ReplayAction recorded = recording.action(round, tank_no);
+        if (!sameOutcome(recorded, actions[tank_no]))
+        {
+            return "diverges at round " + std::to_string(round) + ", tank " + std::to_string(tank_no) + ": recorded " +
+                   describe(recorded) + ", replayed " + describe(actions[tank_no]);
+        }
+    }
+    return {};
+}
+
+// A text output file doesn't record the board, only the number of tanks can be checked
+static bool sameBoard(const GameManager& game, const ReplayReader& recording)
+{
+    const auto& tanks = game.tanks();
+    if (tanks.size() != recording.tanks())
+        return false;
+    if (!recording.hasHeader())
+        return true;
+
+    const ReplayHeader& header = recording.header();
+    if (ReplayWriter::hashBoard(game.board().getGrid()) != header.board_hash)
+        return false;
+    for (size_t i = 0; i < tanks.size(); ++i)
+    {
+        if (static_cast<uint32_t>(tanks[i]->playerId()) != header.tanks[i].first ||
+            static_cast<uint32_t>(tanks[i]->tankId()) != header.tanks[i].second)
+            return false;
+    }
+    return true;
+}
+
+std::string verifyReplay(const std::string& board_file, const ReplayReader& recording)
+{
+    ReplayPlayerFactory player_factory;
+    ReplayTankAlgorithmFactory algorithm_factory(recording);
+    // No time budgets, the recorded actions already have the timeouts in them, as DoNothing
+    GameOptions options{.headless = true, .write_output = false, .action_time_budget = {}, .game_time_budget = {}};
+    GameManager game{player_factory, algorithm_factory, options};
+    try
+    {
+        if (!game.readBoard(board_file))
+        {
+            return "the board couldn't be loaded";
+        }
+    }
+    catch (const std::invalid_argument&)
+    {
+        // The factory ran out of recorded tanks
+        return "the recording is for a different board";
+    }
+    if (!sameBoard(game, recording))
+    {
+        return "the recording is for a different board";
+    }
+
+    std::string divergence;
+    game.setRoundListener([&recording, &divergence](size_t round, const std::vector<ReplayAction>& actions)
+                          { if (divergence.empty()) divergence = roundDivergence(recording, round, actions); });
+    game.run();
+    if (!divergence.empty())
+    {
+        return divergence;
+    }
+
+    const GameResult& result = game.result();
+    if (result.message != recording.result())
+    {
+        return "ended with \"" + result.message + "\", recorded \"" + recording.result() + "\"";
+    }
+    if (result.rounds != recording.rounds())
+    {
+        return "ended after " + std::to_string(result.rounds) + " rounds, recorded " + std::to_string(recording.rounds());
+    }
+    return {};
+}
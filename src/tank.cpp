@@ -98,6 +98,23 @@ void Tank::copyRuntimeStateFrom(const Tank& other)
     alive_ = other.alive_;
 }
 
+Tank::RuntimeState Tank::runtimeState() const
+{
+    return {position_, direction_, shells_, cooldown_, backwait_, alive_, waiting_back_move_, last_action_};
+}
+
+void Tank::restoreRuntimeState(const RuntimeState& state)
+{
+    position_ = state.position;
+    direction_ = state.direction;
+    shells_ = state.shells;
+    cooldown_ = state.cooldown;
+    backwait_ = state.backwait;
+    alive_ = state.alive;
+    waiting_back_move_ = state.waiting_back_move;
+    last_action_ = state.last_action;
+}
+
 bool Tank::waitingBackMove() const
 {
     return waiting_back_move_;
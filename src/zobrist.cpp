@@ -0,0 +1,66 @@
+#include "zobrist.h"
+
+#include "shell.h"
+#include "wall.h"
+
+
+namespace zobrist
+{
+
+uint64_t objectKey(size_t cell_index, const GameObjectInterface& object)
+{
+    uint64_t descriptor = static_cast<uint64_t>(object.type());
+    switch (object.type())
+    {
+    case ObjectType::Tank:
+    {
+        const auto& tank = static_cast<const Tank&>(object);
+        descriptor |= static_cast<uint64_t>(tank.direction()) << 2 |
+                      static_cast<uint64_t>(tank.playerId()) << 5 |
+                      static_cast<uint64_t>(tank.tankId()) << 13;
+        break;
+    }
+    case ObjectType::Shell:
+    {
+        descriptor |= static_cast<uint64_t>(static_cast<const Shell&>(object).direction()) << 2;
+        break;
+    }
+    case ObjectType::Wall:
+    {
+        descriptor |= static_cast<uint64_t>(static_cast<const Wall&>(object).hitCount()) << 2;
+        break;
+    }
+    case ObjectType::Mine:
+    {
+        break;
+    }
+    }
+
+    return mix(mix(cell_index) ^ descriptor);
+}
+
+uint64_t cellKey(size_t cell_index, const Cell& cell)
+{
+    uint64_t key = 0;
+    for (ObjectType type : {ObjectType::Tank, ObjectType::Shell, ObjectType::Mine, ObjectType::Wall})
+    {
+        for (const auto* object : cell.getObjectsByType(type))
+        {
+            key ^= objectKey(cell_index, *object);
+        }
+    }
+    return key;
+}
+
+uint64_t tankStateKey(const Tank& tank)
+{
+    uint64_t key = mix(static_cast<uint64_t>(tank.playerId()) << 32 | static_cast<uint32_t>(tank.tankId()));
+    key = mix(key ^ tank.isAlive());
+    key = mix(key ^ tank.ammo());
+    key = mix(key ^ tank.cooldown());
+    key = mix(key ^ tank.backwait());
+    key = mix(key ^ tank.waitingBackMove());
+    return mix(key ^ static_cast<uint64_t>(tank.lastAction()));
+}
+
+} // namespace zobrist
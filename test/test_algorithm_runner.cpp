@@ -0,0 +1,319 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "TankAlgorithmFactory.h"
+#include "algorithm_runner.h"
+#include "algorithms/algorithm_base.h"
+#include "algorithms/algorithm_utils.h"
+#include "board_generator.h"
+#include "concrete_player_factory.h"
+#include "concrete_tank_algorithm_factory.h"
+#include "game_manager.h"
+#include "replay.h"
+#include "replay_factories.h"
+#include "smart_battle_info.h"
+
+
+using namespace std::chrono_literals;
+
+namespace
+{
+
+// Sleeps through its first calls, then answers at once, its action tells which call it is
+class SlowAlgorithm : public TankAlgorithm, public DroppedActionListener
+{
+public:
+    SlowAlgorithm(std::chrono::milliseconds delay, size_t slow_calls = 1) : delay_(delay), slow_calls_(slow_calls) {}
+
+    virtual ActionRequest getAction() override
+    {
+        size_t call = calls_++;
+        if (call < slow_calls_)
+        {
+            std::this_thread::sleep_for(delay_);
+        }
+        return call % 2 == 0 ? ActionRequest::RotateLeft90 : ActionRequest::RotateRight90;
+    }
+
+    virtual void updateBattleInfo(BattleInfo& info) override { (void)info; }
+    virtual void actionDropped() override { ++dropped_; }
+
+    size_t calls() const { return calls_; }
+    size_t dropped() const { return dropped_; }
+
+private:
+    std::chrono::milliseconds delay_;
+    size_t slow_calls_;
+    std::atomic<size_t> calls_ = 0;
+    size_t dropped_ = 0;
+};
+
+// Moves forward every turn, its first move comes late
+class SlowMoverAlgorithm : public AlgorithmBase
+{
+public:
+    SlowMoverAlgorithm() : AlgorithmBase(1, 0) {}
+
+    Position position() const { return tank_->position(); }
+    Direction direction() const { return tank_->direction(); }
+
+protected:
+    virtual ActionRequest getActionImpl() override
+    {
+        if (moves_++ == 0)
+        {
+            std::this_thread::sleep_for(200ms);
+        }
+        return ActionRequest::MoveForward;
+    }
+
+private:
+    size_t moves_ = 0;
+};
+
+// Counts how many of its kind choose at the same time
+class OverlapAlgorithm : public TankAlgorithm
+{
+public:
+    explicit OverlapAlgorithm(std::atomic<size_t>& running, std::atomic<size_t>& max_running) : running_(running), max_running_(max_running) {}
+
+    virtual ActionRequest getAction() override
+    {
+        size_t running = ++running_;
+        size_t max_running = max_running_;
+        while (running > max_running && !max_running_.compare_exchange_weak(max_running, running))
+        {
+        }
+        std::this_thread::sleep_for(50ms);
+        --running_;
+        return ActionRequest::Shoot;
+    }
+
+    virtual void updateBattleInfo(BattleInfo& info) override { (void)info; }
+
+private:
+    std::atomic<size_t>& running_;
+    std::atomic<size_t>& max_running_;
+};
+
+class SlowAlgorithmFactory : public TankAlgorithmFactory
+{
+public:
+    virtual std::unique_ptr<TankAlgorithm> create(int player_index, int tank_index) const override
+    {
+        (void)tank_index;
+        return std::make_unique<SlowAlgorithm>(player_index == 1 ? 300ms : 0ms);
+    }
+};
+
+} // namespace
+
+TEST(AlgorithmRunnerTest, WithoutBudgetsCallsInPlace)
+{
+    SlowAlgorithm algorithm(0ms);
+    AlgorithmRunner runner(1, 0ns, 0ns);
+    EXPECT_FALSE(runner.enforced());
+
+    TimedAction timed_action = runner.getAction(0, algorithm);
+    EXPECT_EQ(timed_action.action, ActionRequest::RotateLeft90);
+    EXPECT_FALSE(timed_action.timed_out);
+    EXPECT_EQ(runner.timeouts(), 0u);
+}
+
+TEST(AlgorithmRunnerTest, LateCallIsDroppedAndWaitedFor)
+{
+    SlowAlgorithm algorithm(300ms);
+    AlgorithmRunner runner(1, 20ms, 0ns);
+
+    auto start = std::chrono::steady_clock::now();
+    TimedAction timed_action = runner.getAction(0, algorithm);
+    EXPECT_LT(std::chrono::steady_clock::now() - start, 250ms);
+    EXPECT_EQ(timed_action.action, ActionRequest::DoNothing);
+    EXPECT_TRUE(timed_action.timed_out);
+
+    // Not asked again while its call is still running
+    timed_action = runner.getAction(0, algorithm);
+    EXPECT_TRUE(timed_action.timed_out);
+    EXPECT_EQ(algorithm.calls(), 1u);
+
+    std::this_thread::sleep_for(400ms);
+    timed_action = runner.getAction(0, algorithm);
+    EXPECT_FALSE(timed_action.timed_out);
+    EXPECT_EQ(timed_action.action, ActionRequest::RotateRight90); // The second call's
+    EXPECT_EQ(runner.timeouts(), 2u);
+    EXPECT_EQ(algorithm.dropped(), 1u);
+}
+
+TEST(AlgorithmRunnerTest, DroppedMoveIsTakenBack)
+{
+    auto snapshot = std::make_shared<SatelliteSnapshot>(5, 3);
+    snapshot->at(2, 1) = '%';
+    SmartBattleInfo info(snapshot, 3, 5, 100, 10);
+
+    SlowMoverAlgorithm algorithm;
+    EXPECT_EQ(algorithm.getAction(), ActionRequest::GetBattleInfo);
+    algorithm.updateBattleInfo(info);
+    Position start = algorithm.position();
+
+    AlgorithmRunner runner(1, 20ms, 0ns);
+    EXPECT_TRUE(runner.getAction(0, algorithm).timed_out);
+    std::this_thread::sleep_for(300ms);
+
+    // The late move never happened, the tank moves one cell from where it was
+    TimedAction timed_action = runner.getAction(0, algorithm);
+    EXPECT_FALSE(timed_action.timed_out);
+    EXPECT_EQ(timed_action.action, ActionRequest::MoveForward);
+    EXPECT_EQ(algorithm.position(), forwardPosition(start, algorithm.direction(), 5, 3));
+}
+
+TEST(AlgorithmRunnerTest, SpentGameBudgetStopsTheCalls)
+{
+    SlowAlgorithm algorithm(100ms, 2);
+    AlgorithmRunner runner(1, 0ns, 150ms);
+
+    EXPECT_FALSE(runner.getAction(0, algorithm).timed_out);
+    EXPECT_TRUE(runner.getAction(0, algorithm).timed_out); // Cut off with 50ms left
+
+    std::this_thread::sleep_for(200ms);
+    EXPECT_TRUE(runner.getAction(0, algorithm).timed_out);
+    EXPECT_EQ(algorithm.calls(), 2u);
+}
+
+TEST(AlgorithmRunnerTest, RoundCallsOverlap)
+{
+    std::atomic<size_t> running = 0;
+    std::atomic<size_t> max_running = 0;
+    std::vector<std::unique_ptr<OverlapAlgorithm>> owned;
+    std::vector<TankAlgorithm*> algorithms;
+    for (size_t i = 0; i < 6; ++i)
+    {
+        owned.push_back(std::make_unique<OverlapAlgorithm>(running, max_running));
+        algorithms.push_back(i == 2 ? nullptr : owned.back().get()); // A dead tank
+    }
+
+    AlgorithmRunner runner(algorithms.size(), 0ns, 0ns, 4);
+    std::vector<TimedAction> actions;
+    runner.getActions(algorithms, actions);
+
+    ASSERT_EQ(actions.size(), 6u);
+    for (size_t i = 0; i < actions.size(); ++i)
+    {
+        EXPECT_EQ(actions[i].action, i == 2 ? ActionRequest::DoNothing : ActionRequest::Shoot);
+        EXPECT_FALSE(actions[i].timed_out);
+    }
+    EXPECT_GT(max_running.load(), 1u);
+    EXPECT_LE(max_running.load(), 4u);
+}
+
+TEST(AlgorithmRunnerTest, BudgetedRoundCallsStayWithinTheThreads)
+{
+    std::atomic<size_t> running = 0;
+    std::atomic<size_t> max_running = 0;
+    std::vector<std::unique_ptr<OverlapAlgorithm>> owned;
+    std::vector<TankAlgorithm*> algorithms;
+    for (size_t i = 0; i < 6; ++i)
+    {
+        owned.push_back(std::make_unique<OverlapAlgorithm>(running, max_running));
+        algorithms.push_back(owned.back().get());
+    }
+
+    AlgorithmRunner runner(algorithms.size(), 1s, 0ns, 2);
+    std::vector<TimedAction> actions;
+    runner.getActions(algorithms, actions);
+
+    for (const TimedAction& action : actions)
+    {
+        EXPECT_EQ(action.action, ActionRequest::Shoot);
+        EXPECT_FALSE(action.timed_out);
+    }
+    EXPECT_EQ(max_running.load(), 2u);
+}
+
+TEST(AlgorithmRunnerTest, RoundDeadlinesRunTogether)
+{
+    SlowAlgorithm slow(300ms);
+    SlowAlgorithm fast(0ms);
+    SlowAlgorithm also_slow(300ms);
+    AlgorithmRunner runner(3, 50ms, 0ns, 2);
+    std::vector<TimedAction> actions;
+
+    auto start = std::chrono::steady_clock::now();
+    runner.getActions({&slow, &fast, &also_slow}, actions);
+    EXPECT_LT(std::chrono::steady_clock::now() - start, 250ms); // Not one deadline after the other
+
+    EXPECT_TRUE(actions[0].timed_out);
+    EXPECT_FALSE(actions[1].timed_out);
+    EXPECT_EQ(actions[1].action, ActionRequest::RotateLeft90);
+    EXPECT_TRUE(actions[2].timed_out);
+    EXPECT_EQ(runner.timeouts(), 2u);
+}
+
+TEST(AlgorithmRunnerTest, ParallelGameMatchesSerialGame)
+{
+    auto directory = std::filesystem::temp_directory_path() / "tanks_game_parallel_test";
+    std::filesystem::create_directories(directory);
+    BoardGeneratorOptions board{.width = 30, .height = 30, .players = 3, .tanks_per_player = 3, .max_steps = 200, .seed = 11};
+    ASSERT_TRUE(BoardGenerator(board).writeToFile((directory / "board.txt").string()));
+
+    std::string outputs[2];
+    for (size_t threads : {1, 4})
+    {
+        ConcretePlayerFactory player_factory;
+        ConcreteTankAlgorithmFactory algorithm_factory;
+        {
+            GameManager game(player_factory, algorithm_factory, GameOptions{.headless = true, .action_threads = threads});
+            ASSERT_TRUE(game.readBoard((directory / "board.txt").string()));
+            game.run();
+        }
+        std::ifstream in(directory / "output_board.txt", std::ios::binary);
+        std::stringstream output;
+        output << in.rdbuf();
+        outputs[threads == 1 ? 0 : 1] = output.str();
+    }
+    EXPECT_FALSE(outputs[0].empty());
+    EXPECT_EQ(outputs[0], outputs[1]);
+
+    std::filesystem::remove_all(directory);
+}
+
+TEST(AlgorithmRunnerTest, TimeoutsAreInTheOutputFile)
+{
+    auto directory = std::filesystem::temp_directory_path() / "tanks_game_runner_test";
+    std::filesystem::create_directories(directory);
+    std::filesystem::copy_file("../test/board.txt", directory / "board.txt", std::filesystem::copy_options::overwrite_existing);
+
+    ReplayPlayerFactory player_factory;
+    SlowAlgorithmFactory algorithm_factory;
+    GameResult result;
+    {
+        GameManager game(player_factory, algorithm_factory, GameOptions{.headless = true, .action_time_budget = 20ms});
+        ASSERT_TRUE(game.readBoard((directory / "board.txt").string()));
+        game.run();
+        result = game.result();
+    }
+    EXPECT_GE(result.timeouts, 1u);
+
+    auto output_file = directory / "output_board.txt";
+    std::ifstream in(output_file, std::ios::binary);
+    std::stringstream output;
+    output << in.rdbuf();
+    EXPECT_EQ(output.str().substr(0, output.str().find(", ")), "DoNothing (timed out)");
+
+    ReplayReader recording(output_file.string());
+    ASSERT_TRUE(recording.is_valid());
+    EXPECT_TRUE(recording.action(0, 0).timed_out);
+    std::ostringstream text;
+    recording.writeText(text);
+    EXPECT_EQ(text.str(), output.str());
+
+    std::filesystem::remove_all(directory);
+}
@@ -0,0 +1,115 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+#include "board.h"
+#include "concrete_player_factory.h"
+#include "concrete_tank_algorithm_factory.h"
+
+
+namespace
+{
+
+std::atomic<bool> counting_allocations{false};
+std::atomic<size_t> allocations_count{0};
+
+// Counts the heap allocations made while alive, on any thread
+// Keep it scoped to the code under test, gtest assertions allocate too
+class AllocationCounter
+{
+public:
+    AllocationCounter()
+    {
+        allocations_count = 0;
+        counting_allocations = true;
+    }
+
+    ~AllocationCounter() { counting_allocations = false; }
+
+    size_t count() const { return allocations_count; }
+
+    AllocationCounter(const AllocationCounter&) = delete;
+    AllocationCounter& operator=(const AllocationCounter&) = delete;
+    AllocationCounter(AllocationCounter&&) = delete;
+    AllocationCounter& operator=(AllocationCounter&&) = delete;
+};
+
+} // namespace
+
+void* operator new(size_t size)
+{
+    if (counting_allocations)
+        ++allocations_count;
+
+    if (void* ptr = std::malloc(size == 0 ? 1 : size))
+        return ptr;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* ptr) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, size_t) noexcept
+{
+    std::free(ptr);
+}
+
+class AllocationTest : public ::testing::Test
+{
+protected:
+    ConcretePlayerFactory playerFactory_;
+    ConcreteTankAlgorithmFactory algorithmFactory_;
+    Board board;
+
+    AllocationTest() : board(playerFactory_, algorithmFactory_) {}
+
+    void SetUp() override
+    {
+        ASSERT_TRUE(board.loadFromFile("../test/board.txt").is_valid);
+    }
+};
+
+TEST_F(AllocationTest, TankMoveDoesNotAllocate)
+{
+    auto tank = board.getTank(1, 0);
+    Position old_pos = tank->position();
+    auto action = ActionRequest::MoveForward;
+
+    bool result = false;
+    size_t allocations = 0;
+    {
+        AllocationCounter counter;
+        result = board.executeTankAction(tank, action);
+        board.update();
+        allocations = counter.count();
+    }
+
+    ASSERT_TRUE(result);
+    EXPECT_NE(tank->position(), old_pos);
+    EXPECT_EQ(allocations, 0u);
+}
+
+TEST_F(AllocationTest, ShellStepDoesNotAllocate)
+{
+    auto tank = board.getTank(2, 0);
+    auto action = ActionRequest::Shoot;
+    ASSERT_TRUE(board.executeTankAction(tank, action)); // Firing creates the shell, flying it must not allocate
+    board.update();
+
+    size_t allocations = 0;
+    {
+        AllocationCounter counter;
+        for (int i = 0; i < 3; ++i)
+        {
+            board.doShellsStep();
+            board.update();
+        }
+        allocations = counter.count();
+    }
+
+    EXPECT_EQ(allocations, 0u);
+}
@@ -0,0 +1,111 @@
+#include <gtest/gtest.h>
+
+#include <array>
+#include <vector>
+
+#include "board.h"
+#include "concrete_player_factory.h"
+#include "concrete_tank_algorithm_factory.h"
+
+
+namespace
+{
+
+// Shooting, moving and rotating tanks, so shells fly, hit walls and mines, and tanks may die
+constexpr std::array<ActionRequest, 7> kScript = {ActionRequest::Shoot, ActionRequest::MoveForward, ActionRequest::RotateLeft45,
+                                                  ActionRequest::Shoot, ActionRequest::MoveBackward, ActionRequest::RotateRight90,
+                                                  ActionRequest::GetBattleInfo};
+
+void playRound(Board& board, size_t round, size_t variant = 0)
+{
+    for (int player_id : {1, 2})
+    {
+        auto action = kScript[(round * (variant + 1) + player_id + variant) % kScript.size()];
+        board.executeTankAction(board.getTank(player_id, 0), action);
+    }
+    board.doShellsStep(false);
+    board.doShellsStep(true);
+}
+
+} // namespace
+
+class CheckpointTest : public ::testing::Test
+{
+protected:
+    ConcretePlayerFactory playerFactory_;
+    ConcreteTankAlgorithmFactory algorithmFactory_;
+    Board board;
+    Board reference; // Plays the same rounds, never simulating ahead
+
+    CheckpointTest() : board(playerFactory_, algorithmFactory_), reference(playerFactory_, algorithmFactory_) {}
+
+    void SetUp() override
+    {
+        ASSERT_TRUE(board.loadFromFile("../test/board.txt").is_valid);
+        ASSERT_TRUE(reference.loadFromFile("../test/board.txt").is_valid);
+    }
+};
+
+TEST_F(CheckpointTest, RollbackUndoesSimulatedRounds)
+{
+    for (size_t round = 0; round < 40; ++round)
+    {
+        uint64_t hash = board.hash();
+
+        // Try a few different futures from every round, each one rolled back
+        for (size_t variant = 1; variant <= 3; ++variant)
+        {
+            Board::Checkpoint checkpoint = board.checkpoint();
+            for (size_t ahead = 0; ahead < 5; ++ahead)
+            {
+                playRound(board, round + ahead, variant);
+            }
+            board.rollback(checkpoint);
+            ASSERT_EQ(board.hash(), hash) << "round " << round << " variant " << variant;
+            ASSERT_EQ(board.computeHash(), hash) << "round " << round << " variant " << variant;
+        }
+
+        // The rounds actually played are not affected by the ones simulated
+        playRound(board, round);
+        playRound(reference, round);
+        ASSERT_EQ(board.hash(), reference.hash()) << "round " << round;
+    }
+}
+
+TEST_F(CheckpointTest, NestedCheckpoints)
+{
+    uint64_t initial_hash = board.hash();
+
+    Board::Checkpoint outer = board.checkpoint();
+    playRound(board, 0);
+    playRound(board, 1);
+    uint64_t outer_hash = board.hash();
+
+    Board::Checkpoint inner = board.checkpoint();
+    playRound(board, 2, 1);
+    playRound(board, 3, 1);
+    board.rollback(inner);
+    EXPECT_EQ(board.hash(), outer_hash);
+
+    inner = board.checkpoint();
+    playRound(board, 2);
+    board.commit(inner);
+
+    board.rollback(outer);
+    EXPECT_EQ(board.hash(), initial_hash);
+    EXPECT_EQ(board.computeHash(), initial_hash);
+}
+
+TEST_F(CheckpointTest, CommitKeepsTheChanges)
+{
+    for (size_t round = 0; round < 20; ++round)
+    {
+        Board::Checkpoint checkpoint = board.checkpoint();
+        playRound(board, round);
+        board.commit(checkpoint);
+
+        playRound(reference, round);
+        ASSERT_EQ(board.hash(), reference.hash()) << "round " << round;
+        ASSERT_EQ(board.computeHash(), reference.hash()) << "round " << round;
+    }
+}
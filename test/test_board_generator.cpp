@@ -0,0 +1,121 @@
+#include <gtest/gtest.h>
+
+#include <filesystem>
+#include <string>
+
+#include "board.h"
+#include "board_generator.h"
+#include "concrete_player_factory.h"
+#include "concrete_tank_algorithm_factory.h"
+#include "game_manager.h"
+
+
+class BoardGeneratorTest : public ::testing::Test
+{
+protected:
+    ConcretePlayerFactory playerFactory_;
+    ConcreteTankAlgorithmFactory algorithmFactory_;
+    std::filesystem::path directory_;
+
+    // A directory per test, so tests running in parallel don't remove each other's boards
+    void SetUp() override
+    {
+        directory_ = std::filesystem::temp_directory_path() /
+                     ("tanks_game_generator_test_" + std::string(::testing::UnitTest::GetInstance()->current_test_info()->name()));
+        std::filesystem::create_directories(directory_);
+    }
+    void TearDown() override { std::filesystem::remove_all(directory_); }
+
+    std::string write(const BoardGeneratorOptions& options)
+    {
+        auto board_file = (directory_ / "board.txt").string();
+        EXPECT_TRUE(BoardGenerator(options).writeToFile(board_file));
+        return board_file;
+    }
+};
+
+TEST_F(BoardGeneratorTest, GeneratedBoardsLoad)
+{
+    BoardGeneratorOptions options{.width = 40, .height = 25, .wall_density = 0.2, .mine_density = 0.05, .players = 3,
+                                  .tanks_per_player = 4, .max_steps = 321, .num_shells = 7, .seed = 42};
+    Board board(playerFactory_, algorithmFactory_);
+    GameInfo info = board.loadFromFile(write(options));
+
+    ASSERT_TRUE(info.is_valid);
+    EXPECT_EQ(board.getWidth(), 40u);
+    EXPECT_EQ(board.getHeight(), 25u);
+    EXPECT_EQ(info.max_steps, 321u);
+    EXPECT_EQ(info.num_shells, 7u);
+    ASSERT_EQ(info.ordered_tanks.size(), 12u);
+    for (int player_id = 1; player_id <= 3; ++player_id)
+    {
+        EXPECT_EQ(board.getPlayerTanks(player_id).size(), 4u);
+    }
+
+    size_t walls = 0;
+    size_t mines = 0;
+    for (size_t y = 0; y < 25; ++y)
+    {
+        for (size_t x = 0; x < 40; ++x)
+        {
+            walls += board.getCell({x, y}).has(ObjectType::Wall) ? 1 : 0;
+            mines += board.getCell({x, y}).has(ObjectType::Mine) ? 1 : 0;
+        }
+    }
+    EXPECT_EQ(walls, 200u);
+    EXPECT_EQ(mines, 50u);
+}
+
+TEST_F(BoardGeneratorTest, SeedDecidesTheBoard)
+{
+    BoardGeneratorOptions options{.width = 30, .height = 30, .seed = 7};
+    std::string board = BoardGenerator(options).generate();
+    EXPECT_EQ(BoardGenerator(options).generate(), board);
+
+    options.seed = 8;
+    EXPECT_NE(BoardGenerator(options).generate(), board);
+}
+
+TEST_F(BoardGeneratorTest, RejectsImpossibleOptions)
+{
+    EXPECT_FALSE(BoardGenerator(BoardGeneratorOptions{.players = 10}).is_valid());
+    EXPECT_FALSE(BoardGenerator(BoardGeneratorOptions{.width = 0}).is_valid());
+    EXPECT_FALSE(BoardGenerator(BoardGeneratorOptions{.width = 4, .height = 4, .wall_density = 0.9, .players = 2,
+                                                      .tanks_per_player = 2}).is_valid());
+    EXPECT_TRUE(BoardGenerator(BoardGeneratorOptions{.width = 4, .height = 4, .wall_density = 0.75, .mine_density = 0,
+                                                     .players = 2, .tanks_per_player = 2}).is_valid());
+    EXPECT_TRUE(BoardGenerator(BoardGeneratorOptions{.players = 10}).generate().empty());
+}
+
+static GameResult playGame(const PlayerFactory& player_factory, const TankAlgorithmFactory& algorithm_factory, const std::string& board_file)
+{
+    GameManager game{player_factory, algorithm_factory, GameOptions{.headless = true, .write_output = false}};
+    EXPECT_TRUE(game.readBoard(board_file));
+    game.run();
+    return game.result();
+}
+
+// A full game on the largest boards with more than a hundred tanks, every one of them keeping its own model of the
+// board and searching it. It takes close to two hours on one core and 2.7GB, so it's left out of the unit suite, see the
+// TANKS_GAME_STRESS_TESTS option
+TEST_F(BoardGeneratorTest, DISABLED_StressGameOnLargeBoard)
+{
+    BoardGeneratorOptions options{.width = 1000, .height = 1000, .wall_density = 0.05, .mine_density = 0.01, .players = 4,
+                                  .tanks_per_player = 26, .max_steps = 100, .num_shells = 100, .seed = 1};
+    GameResult result = playGame(playerFactory_, algorithmFactory_, write(options));
+
+    EXPECT_GT(result.rounds, 0u);
+    EXPECT_LE(result.rounds, 100u);
+    EXPECT_FALSE(result.message.empty());
+}
+
+TEST_F(BoardGeneratorTest, StressGameWithManyTanks)
+{
+    BoardGeneratorOptions options{.width = 80, .height = 80, .wall_density = 0.1, .mine_density = 0.02, .players = 4,
+                                  .tanks_per_player = 26, .max_steps = 50, .num_shells = 5, .seed = 2};
+    GameResult result = playGame(playerFactory_, algorithmFactory_, write(options));
+
+    EXPECT_GT(result.rounds, 0u);
+    EXPECT_LE(result.rounds, 50u);
+    EXPECT_FALSE(result.message.empty());
+}
@@ -0,0 +1,87 @@
+#include <gtest/gtest.h>
+
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <string>
+
+#include "board.h"
+#include "concrete_player_factory.h"
+#include "concrete_tank_algorithm_factory.h"
+#include "global_config.h"
+
+
+class BoardLoaderTest : public ::testing::Test
+{
+protected:
+    ConcretePlayerFactory playerFactory_;
+    ConcreteTankAlgorithmFactory algorithmFactory_;
+    Board board;
+    std::filesystem::path directory_ = std::filesystem::temp_directory_path() / "tanks_game_loader_test";
+
+    BoardLoaderTest() : board(playerFactory_, algorithmFactory_) {}
+
+    void SetUp() override { std::filesystem::create_directories(directory_); }
+    void TearDown() override { std::filesystem::remove_all(directory_); }
+
+    GameInfo load(const std::string& contents)
+    {
+        auto board_file = directory_ / "board.txt";
+        std::ofstream(board_file, std::ios::binary) << contents;
+        return board.loadFromFile(board_file.string());
+    }
+};
+
+TEST_F(BoardLoaderTest, ShortAndMissingRowsAreEmpty)
+{
+    // The last row has no line break, and the rows after it are missing
+    GameInfo info = load("Test\nMaxSteps = 50\nNumShells=3\nRows = 4\nCols= 5\n#1\n@......#\n   2");
+    ASSERT_TRUE(info.is_valid);
+    EXPECT_EQ(board.getWidth(), 5u);
+    EXPECT_EQ(board.getHeight(), 4u);
+    EXPECT_EQ(info.ordered_tanks.size(), 2u);
+
+    EXPECT_TRUE(board.getCell({0, 0}).has(ObjectType::Wall));
+    EXPECT_TRUE(board.getCell({1, 0}).has(ObjectType::Tank));
+    EXPECT_TRUE(board.getCell({2, 0}).empty());
+    EXPECT_TRUE(board.getCell({0, 1}).has(ObjectType::Mine));
+    EXPECT_TRUE(board.getCell({4, 1}).empty()); // Past the width
+    EXPECT_TRUE(board.getCell({3, 2}).has(ObjectType::Tank));
+    for (size_t x = 0; x < 5; ++x)
+    {
+        EXPECT_TRUE(board.getCell({x, 3}).empty());
+    }
+}
+
+TEST_F(BoardLoaderTest, MetadataIsParsedLeniently)
+{
+    GameInfo info = load("Test\r\nMaxSteps = +20\r\nNumShells =  4\r\nRows = 1\r\nCols = 4\r\n1..2\r\n");
+    ASSERT_TRUE(info.is_valid);
+    EXPECT_EQ(info.max_steps, 20u);
+    EXPECT_EQ(info.num_shells, 4u);
+    EXPECT_EQ(board.getWidth(), 4u);
+}
+
+TEST_F(BoardLoaderTest, MalformedMetadataIsInvalid)
+{
+    EXPECT_FALSE(load("Test\nMaxSteps = many\nNumShells = 4\nRows = 1\nCols = 4\n1..2\n").is_valid);
+    EXPECT_FALSE(load("Test\nNumShells = 4\nRows = 1\nCols = 4\n1..2\n").is_valid);
+}
+
+TEST_F(BoardLoaderTest, MissingFileIsInvalid)
+{
+    EXPECT_FALSE(board.loadFromFile((directory_ / "missing.txt").string()).is_valid);
+}
+
+TEST_F(BoardLoaderTest, ErrorsOfEveryBoardAreKept)
+{
+    std::string first = (directory_ / "first_missing.txt").string();
+    std::string second = (directory_ / "second_missing.txt").string();
+    EXPECT_FALSE(board.loadFromFile(first).is_valid);
+    EXPECT_FALSE(board.loadFromFile(second).is_valid);
+
+    std::ifstream errors_file(std::string(config::get<std::string_view>("input_error_file")));
+    std::string errors((std::istreambuf_iterator<char>(errors_file)), std::istreambuf_iterator<char>());
+    EXPECT_NE(errors.find("Board " + first + ":"), std::string::npos);
+    EXPECT_NE(errors.find("Board " + second + ":"), std::string::npos);
+}
@@ -0,0 +1,46 @@
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include "shell_directions.h"
+#include "types/direction.h"
+
+
+TEST(DirectionSetTest, SetOperationsAndIterationOrder)
+{
+    DirectionSet set = {Direction::L, Direction::U, Direction::DR};
+    EXPECT_EQ(set.size(), 3u);
+    EXPECT_TRUE(set.contains(Direction::DR));
+    EXPECT_FALSE(set.contains(Direction::D));
+
+    std::vector<Direction> directions(set.begin(), set.end());
+    EXPECT_EQ(directions, (std::vector<Direction>{Direction::U, Direction::DR, Direction::L}));
+
+    EXPECT_EQ(set & DirectionSet({Direction::L, Direction::R}), DirectionSet({Direction::L}));
+    EXPECT_EQ((set | DirectionSet::all()).size(), 8u);
+
+    set.erase(Direction::U);
+    EXPECT_EQ(set, (DirectionSet{Direction::DR, Direction::L}));
+    EXPECT_TRUE(DirectionSet().empty());
+}
+
+TEST(ShellDirectionsTest, KeepsShellsSortedByPosition)
+{
+    ShellDirections shells;
+    shells.set(Position(3, 1), {Direction::R});
+    shells.set(Position(0, 4), {Direction::U});
+    shells.set(Position(3, 0), {Direction::D});
+    shells.set(Position(3, 1), {Direction::L}); // Replaces
+
+    ASSERT_EQ(shells.size(), 3u);
+    std::vector<Position> positions;
+    for (const auto& [pos, directions] : shells)
+    {
+        positions.push_back(pos);
+    }
+    EXPECT_EQ(positions, (std::vector<Position>{{0, 4}, {3, 0}, {3, 1}}));
+
+    ASSERT_NE(shells.find(Position(3, 1)), nullptr);
+    EXPECT_EQ(*shells.find(Position(3, 1)), DirectionSet({Direction::L}));
+    EXPECT_EQ(shells.find(Position(1, 1)), nullptr);
+}
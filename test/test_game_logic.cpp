@@ -34,7 +34,8 @@ TEST_F(BoardTest, TankStepsOnMineAndDies)
 
     // Place tank next to a mine
     tank->position() = std::make_pair(2, 2); // Assume (2,2) has a mine nearby at (2,3)
-    board.grid()[2][2] = Cell({2, 2}, tank);
+    board.grid()[{2, 2}] = Cell();
+    board.grid()[{2, 2}].addObject(tank.get());
 
     // Move forward into the mine
     tank->direction() = Direction::R;
@@ -51,7 +52,8 @@ TEST_F(BoardTest, TankCannotPassThroughWall)
     auto tank = board.getTank(2, 0); // Get the first tank of player 2
 
     tank->position() = std::make_pair(5, 0);
-    board.grid()[5][0] = Cell({5, 0}, tank);
+    board.grid()[{5, 0}] = Cell();
+    board.grid()[{5, 0}].addObject(tank.get());
 
     tank->direction() = Direction::L;
     auto action = ActionRequest::MoveForward;
@@ -73,8 +75,10 @@ TEST_F(BoardTest, TankShootsAndHitsOtherTank)
     tank1->direction() = Direction::R;
     tank2->direction() = Direction::L;
 
-    board.grid()[4][5] = Cell({4, 5}, tank1);
-    board.grid()[5][5] = Cell({5, 5}, tank2);
+    board.grid()[{4, 5}] = Cell();
+    board.grid()[{4, 5}].addObject(tank1.get());
+    board.grid()[{5, 5}] = Cell();
+    board.grid()[{5, 5}].addObject(tank2.get());
 
     // Tank1 shoots
     auto action = ActionRequest::Shoot;
@@ -181,7 +185,7 @@ TEST_F(BoardTest, ShellMovesTwoStepsPerTick)
             const auto& cell = board.getCell(Position(x, y));
             if (cell.has(ObjectType::Shell))
             {
-                oldPos = cell.position();
+                oldPos = Position(x, y);
                 break;
             }
         }
@@ -199,7 +203,7 @@ TEST_F(BoardTest, ShellMovesTwoStepsPerTick)
             const auto& cell = board.getCell(Position(x, y));
             if (cell.has(ObjectType::Shell))
             {
-                newPos = cell.position();
+                newPos = Position(x, y);
                 break;
             }
         }
@@ -212,7 +216,7 @@ TEST_F(BoardTest, ShellMovesTwoStepsPerTick)
 TEST_F(BoardTest, WallDestroyedAfterTwoShellHits)
 {
     Position wallPos = {5, 5};
-    board.grid()[wallPos.second][wallPos.first].addObject(std::make_shared<Wall>());
+    board.grid().emplace<Wall>(wallPos);
 
     auto tank = board.getTank(1, 0); // Get the first tank of player 1
     tank->position() = std::make_pair(4, 5);
@@ -228,7 +232,7 @@ TEST_F(BoardTest, WallDestroyedAfterTwoShellHits)
     board.executeTankAction(tank, shoot);
     board.update();
 
-    EXPECT_FALSE(board.grid()[wallPos.second][wallPos.first].has(ObjectType::Wall));
+    EXPECT_FALSE(board.grid()[wallPos].has(ObjectType::Wall));
 }
 
 TEST_F(BoardTest, ShellCollisionDestroysBothShells)
@@ -258,6 +262,41 @@ TEST_F(BoardTest, ShellCollisionDestroysBothShells)
     }
 }
 
+TEST_F(BoardTest, ShellsCrossingEachOtherAreDestroyed)
+{
+    auto tank1 = board.getTank(1, 0); // Get the first tank of player 1
+    auto tank2 = board.getTank(2, 0); // Get the first tank of player 2
+
+    // Shells are fired into adjacent cells, so they swap cells on the next shells step
+    tank1->position() = std::make_pair(3, 5);
+    tank2->position() = std::make_pair(6, 5);
+    tank1->direction() = Direction::R;
+    tank2->direction() = Direction::L;
+
+    auto shoot = ActionRequest::Shoot;
+    board.executeTankAction(tank1, shoot);
+    board.executeTankAction(tank2, shoot);
+    board.update();
+
+    EXPECT_TRUE(board.getCell({4, 5}).has(ObjectType::Shell));
+    EXPECT_TRUE(board.getCell({5, 5}).has(ObjectType::Shell));
+
+    board.doShellsStep();
+
+    EXPECT_FALSE(board.getCell({4, 5}).has(ObjectType::Shell));
+    EXPECT_FALSE(board.getCell({5, 5}).has(ObjectType::Shell));
+
+    // Crossing shells are gone for good, and do not come back in later steps
+    board.doShellsStep();
+    for (size_t x = 0; x < board.getWidth(); ++x)
+    {
+        for (size_t y = 0; y < board.getHeight(); ++y)
+        {
+            ASSERT_FALSE(board.getCell(Position(x, y)).has(ObjectType::Shell));
+        }
+    }
+}
+
 TEST_F(BoardTest, TankWrapsAroundBoardEdges)
 {
     auto tank = board.getTank(1, 0);         // Get the first tank of player 1
@@ -270,3 +309,18 @@ TEST_F(BoardTest, TankWrapsAroundBoardEdges)
     EXPECT_EQ(tank->position().first, 0); // Wrapped around horizontally
     EXPECT_EQ(tank->position().second, 9);
 }
+
+TEST(BoardLoadTest, NonSquareBoardIsIndexedByColumnAndRow)
+{
+    ConcretePlayerFactory player_factory;
+    ConcreteTankAlgorithmFactory algorithm_factory;
+    Board board(player_factory, algorithm_factory);
+    ASSERT_TRUE(board.loadFromFile("../test/board_wide.txt").is_valid);
+
+    EXPECT_EQ(board.getWidth(), 7u);
+    EXPECT_EQ(board.getHeight(), 3u);
+    EXPECT_TRUE(board.getCell({6, 0}).has(ObjectType::Wall));
+    EXPECT_TRUE(board.getCell({3, 1}).has(ObjectType::Mine));
+    EXPECT_EQ(board.getTank(2, 0)->position(), Position(5, 2));
+    EXPECT_EQ(board.getGrid().position(board.getGrid().index(board.getCell({5, 2}))), Position(5, 2));
+}
@@ -0,0 +1,68 @@
+#include <gtest/gtest.h>
+
+#include "object_pool.h"
+
+
+namespace
+{
+
+// Counts the live instances, to check the pool runs the destructors
+struct Counted
+{
+    explicit Counted(int value) : value(value) { ++live; }
+    ~Counted() { --live; }
+
+    Counted(const Counted&) = delete;
+    Counted& operator=(const Counted&) = delete;
+    Counted(Counted&&) = delete;
+    Counted& operator=(Counted&&) = delete;
+
+    int value;
+    static inline int live = 0;
+};
+
+} // namespace
+
+TEST(ObjectPoolTest, ReusesDestroyedSlots)
+{
+    ObjectPool<Counted> pool;
+    Counted* first = pool.create(1);
+    Counted* second = pool.create(2);
+    EXPECT_EQ(pool.size(), 2u);
+    EXPECT_EQ(Counted::live, 2);
+
+    pool.destroy(first);
+    EXPECT_EQ(Counted::live, 1);
+    EXPECT_EQ(second->value, 2);
+
+    Counted* third = pool.create(3);
+    EXPECT_EQ(third, first);
+    EXPECT_EQ(third->value, 3);
+    EXPECT_EQ(pool.size(), 2u);
+}
+
+TEST(ObjectPoolTest, ClearDestroysEverythingAndKeepsTheMemory)
+{
+    {
+        ObjectPool<Counted> pool;
+        for (int i = 0; i < 200; ++i)
+        {
+            pool.create(i);
+        }
+        size_t capacity = pool.capacity();
+
+        pool.clear();
+        EXPECT_EQ(Counted::live, 0);
+        EXPECT_EQ(pool.size(), 0u);
+
+        for (int i = 0; i < 200; ++i)
+        {
+            pool.create(i);
+        }
+        EXPECT_EQ(pool.capacity(), capacity);
+        EXPECT_EQ(Counted::live, 200);
+    }
+
+    // The pool's destructor releases whatever is left
+    EXPECT_EQ(Counted::live, 0);
+}
@@ -0,0 +1,76 @@
+#include <gtest/gtest.h>
+
+#include <sstream>
+#include <string>
+
+#include "phase_profiler.h"
+
+
+TEST(PhaseProfilerTest, HistogramBucketsArePowersOfTwo)
+{
+    TimingHistogram histogram;
+    histogram.add(0);
+    histogram.add(1);
+    histogram.add(1023);
+    histogram.add(1024);
+
+    EXPECT_EQ(histogram.count(), 4u);
+    EXPECT_EQ(histogram.totalNs(), 2048u);
+    EXPECT_EQ(histogram.minNs(), 0u);
+    EXPECT_EQ(histogram.maxNs(), 1024u);
+    EXPECT_EQ(histogram.buckets()[0], 2u);
+    EXPECT_EQ(histogram.buckets()[9], 1u);
+    EXPECT_EQ(histogram.buckets()[10], 1u);
+
+    TimingHistogram other;
+    other.add(5000);
+    histogram.merge(other);
+    EXPECT_EQ(histogram.count(), 5u);
+    EXPECT_EQ(histogram.maxNs(), 5000u);
+    EXPECT_EQ(histogram.buckets()[12], 1u);
+}
+
+TEST(PhaseProfilerTest, TimedCallsAlwaysRun)
+{
+    PhaseProfiler profiler;
+    profiler.setTanks({{1, 0}});
+
+    int calls = 0;
+    profiler.time(GamePhase::BoardUpdate, [&]
+                  { ++calls; });
+    profiler.timeAlgorithm(0, [&]
+                           { ++calls; });
+    EXPECT_EQ(calls, 2);
+
+    // Only counted when profiling is compiled in
+    size_t expected = PhaseProfiler::kEnabled ? 1 : 0;
+    EXPECT_EQ(profiler.phase(GamePhase::BoardUpdate).count(), expected);
+    EXPECT_EQ(profiler.algorithm(0).count(), expected);
+}
+
+TEST(PhaseProfilerTest, WritesPhasesPlayersAndTanks)
+{
+    PhaseProfiler profiler;
+    profiler.setTanks({{1, 0}, {2, 0}, {1, 1}});
+    profiler.record(GamePhase::GetActions, 3000);
+    profiler.recordAlgorithm(0, 100);
+    profiler.recordAlgorithm(2, 300);
+    profiler.recordAlgorithm(1, 7);
+
+    std::ostringstream json;
+    profiler.writeJson(json);
+    EXPECT_NE(json.str().find("{\"phase\": \"get_actions\", \"count\": 1, \"total_ns\": 3000, \"min_ns\": 3000, \"max_ns\": 3000, "
+                              "\"buckets\": [[2048, 1]]}"),
+              std::string::npos);
+    EXPECT_NE(json.str().find("{\"player\": 1, \"count\": 2, \"total_ns\": 400, \"min_ns\": 100, \"max_ns\": 300, "
+                              "\"buckets\": [[64, 1], [256, 1]]}"),
+              std::string::npos);
+    EXPECT_NE(json.str().find("{\"player\": 2, \"tank\": 0, \"count\": 1, \"total_ns\": 7"), std::string::npos);
+
+    std::ostringstream csv;
+    profiler.writeCsv(csv);
+    EXPECT_EQ(csv.str().substr(0, csv.str().find('\n')), "scope,name,count,total_ns,min_ns,max_ns,buckets");
+    EXPECT_NE(csv.str().find("\nphase,shells_step,0,0,0,0,\n"), std::string::npos);
+    EXPECT_NE(csv.str().find("\nplayer,1,2,400,100,300,64:1;256:1\n"), std::string::npos);
+    EXPECT_NE(csv.str().find("\ntank,1:1,1,300,300,300,256:1\n"), std::string::npos);
+}
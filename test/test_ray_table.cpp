@@ -0,0 +1,142 @@
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include "algorithms/algorithm_utils.h"
+#include "algorithms/ray_table.h"
+#include "grid.h"
+#include "shell.h"
+#include "shell_directions.h"
+#include "tank.h"
+#include "wall.h"
+
+
+namespace
+{
+
+// Walks the ray the slow way, the first wall or tank ahead (the start cell included once the ray wraps back to it)
+uint32_t walkToBlocker(const Grid& grid, const Position& start, Direction dir)
+{
+    Position current = start;
+    for (uint32_t steps = 1; steps <= grid.size(); ++steps)
+    {
+        current = forwardPosition(current, dir, grid.width(), grid.height());
+        if (grid[current].has(ObjectType::Wall) || grid[current].has(ObjectType::Tank))
+            return steps;
+        if (current == start)
+            break;
+    }
+    return RayTable::no_hit;
+}
+
+// Walks back from the cell the slow way, the first shell that may fly in dir, unless a wall comes first
+uint32_t walkToShell(const Grid& grid, const ShellDirections& shell_directions, const Position& start, Direction dir)
+{
+    Position current = start;
+    for (uint32_t steps = 1; steps <= grid.size(); ++steps)
+    {
+        current = backwardPosition(current, dir, grid.width(), grid.height());
+        if (grid[current].has(ObjectType::Wall))
+            break;
+        if (grid[current].has(ObjectType::Shell))
+        {
+            const DirectionSet* directions = shell_directions.find(current);
+            if (!directions || directions->contains(dir))
+                return steps;
+        }
+        if (current == start)
+            break;
+    }
+    return RayTable::no_hit;
+}
+
+void expectMatchesWalk(const RayTable& rays, const Grid& grid, const ShellDirections& shell_directions)
+{
+    for (size_t i = 0; i < grid.size(); ++i)
+    {
+        for (const auto& dir : getAllDirections())
+        {
+            EXPECT_EQ(rays.blockerDistance(i, dir), walkToBlocker(grid, grid.position(i), dir))
+                << "blocker from cell " << i << " " << directionToString(dir);
+            EXPECT_EQ(rays.shellDistance(i, dir), walkToShell(grid, shell_directions, grid.position(i), dir))
+                << "shell toward cell " << i << " " << directionToString(dir);
+        }
+    }
+}
+
+} // namespace
+
+TEST(RayTableTest, MatchesWalkingTheGridAfterIncrementalUpdates)
+{
+    // Non-square, so diagonal rays wrap around through several rows before coming back
+    Grid grid(7, 4);
+    grid.emplace<Wall>(Position(2, 1));
+    grid.emplace<Wall>(Position(5, 3));
+    grid.emplace<Tank>(Position(6, 0), 2, 0, Position(6, 0), Direction::L, 1);
+    grid.emplace<Shell>(Position(0, 2), Direction::R);
+    grid.emplace<Shell>(Position(4, 0), Direction::U);
+
+    ShellDirections shell_directions;
+    shell_directions.set(Position(4, 0), {Direction::D, Direction::DL});
+
+    RayTable rays;
+    EXPECT_FALSE(rays.built());
+    rays.rebuild(grid, shell_directions);
+    EXPECT_TRUE(rays.built());
+    expectMatchesWalk(rays, grid, shell_directions);
+
+    // Drive a tank around the board, updating only the cells it leaves and enters
+    Tank* tank = grid.emplace<Tank>(Position(0, 0), 1, 0, Position(0, 0), Direction::R, 1);
+    rays.updateCell(grid, shell_directions, grid.index(0, 0));
+    expectMatchesWalk(rays, grid, shell_directions);
+
+    Position pos(0, 0);
+    for (Direction dir : {Direction::R, Direction::R, Direction::DR, Direction::D, Direction::D, Direction::UL, Direction::L})
+    {
+        Position next = forwardPosition(pos, dir, grid.width(), grid.height());
+        grid[pos].removeObject(tank);
+        grid[next].addObject(tank);
+        rays.updateCell(grid, shell_directions, grid.index(pos));
+        rays.updateCell(grid, shell_directions, grid.index(next));
+        pos = next;
+
+        expectMatchesWalk(rays, grid, shell_directions);
+    }
+
+    // A wall falling opens up every ray that went through it
+    grid.at(2, 1).removeObjectsByType(ObjectType::Wall);
+    rays.updateCell(grid, shell_directions, grid.index(2, 1));
+    expectMatchesWalk(rays, grid, shell_directions);
+}
+
+TEST(RayTableTest, UpdateCellsFollowsABattleInfo)
+{
+    Grid grid(24, 12); // Big enough for a few changed cells to be updated one by one
+    grid.emplace<Wall>(Position(3, 2));
+    grid.emplace<Tank>(Position(7, 4), 2, 0, Position(7, 4), Direction::L, 1);
+    Shell* shell = grid.emplace<Shell>(Position(1, 1), Direction::U);
+
+    ShellDirections shell_directions;
+    shell_directions.set(Position(1, 1), {Direction::R});
+
+    RayTable rays;
+    rays.rebuild(grid, shell_directions);
+    expectMatchesWalk(rays, grid, shell_directions);
+
+    // The shell moved on, a wall appeared and the tank left, as a few cells of a new satellite view
+    grid.at(1, 1).removeObject(shell);
+    grid.at(3, 1).addObject(shell);
+    grid.emplace<Wall>(Position(5, 0));
+    grid.at(7, 4).removeObjectsByType(ObjectType::Tank);
+    shell_directions.clear();
+    shell_directions.set(Position(3, 1), {Direction::R, Direction::DR});
+
+    std::vector<size_t> changed_cells = {grid.index(1, 1), grid.index(3, 1), grid.index(5, 0), grid.index(7, 4)};
+    rays.updateCells(grid, shell_directions, changed_cells);
+    expectMatchesWalk(rays, grid, shell_directions);
+
+    // Only what's known about the shell changed
+    shell_directions.set(Position(3, 1), {Direction::L});
+    rays.updateCell(grid, shell_directions, grid.index(3, 1));
+    expectMatchesWalk(rays, grid, shell_directions);
+}
@@ -0,0 +1,215 @@
+#include <gtest/gtest.h>
+
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <set>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "board_generator.h"
+#include "concrete_player_factory.h"
+#include "concrete_tank_algorithm_factory.h"
+#include "game_manager.h"
+#include "replay.h"
+#include "replay_factories.h"
+#include "replay_verifier.h"
+
+
+namespace
+{
+
+std::string readFile(const std::filesystem::path& path)
+{
+    std::ifstream in(path, std::ios::binary);
+    std::stringstream content;
+    content << in.rdbuf();
+    return content.str();
+}
+
+// Plays the test board in a temporary directory, recording a replay next to the output file
+std::filesystem::path recordGame(const std::string& directory_name)
+{
+    auto directory = std::filesystem::temp_directory_path() / directory_name;
+    std::filesystem::create_directories(directory);
+    std::filesystem::copy_file("../test/board.txt", directory / "board.txt", std::filesystem::copy_options::overwrite_existing);
+
+    ConcretePlayerFactory player_factory;
+    ConcreteTankAlgorithmFactory algorithm_factory;
+    GameManager game(player_factory, algorithm_factory, GameOptions{.headless = true, .record_replay = true});
+    EXPECT_TRUE(game.readBoard((directory / "board.txt").string()));
+    game.run();
+    return directory;
+}
+
+// Plays the board again with every tank repeating its recorded actions
+GameResult resimulate(const std::filesystem::path& board_file, const ReplayReader& recording)
+{
+    ReplayPlayerFactory player_factory;
+    ReplayTankAlgorithmFactory algorithm_factory(recording);
+    GameManager game(player_factory, algorithm_factory, GameOptions{.headless = true, .write_output = false});
+    EXPECT_TRUE(game.readBoard(board_file.string()));
+    game.run();
+    return game.result();
+}
+
+} // namespace
+
+TEST(ReplayTest, PackedActionRoundTrips)
+{
+    for (int code = 0; code <= static_cast<int>(ActionRequest::DoNothing); ++code)
+    {
+        ReplayAction replay_action{static_cast<ActionRequest>(code), code % 2 == 0, true, code % 3 == 0};
+        ReplayAction unpacked = ReplayAction::unpack(replay_action.pack());
+        EXPECT_EQ(unpacked.action, replay_action.action);
+        EXPECT_EQ(unpacked.valid, replay_action.valid);
+        EXPECT_EQ(unpacked.alive_at_start, replay_action.alive_at_start);
+        EXPECT_EQ(unpacked.killed, replay_action.killed);
+        EXPECT_NE(replay_action.pack(), ReplayAction::kEndOfRounds);
+    }
+
+    EXPECT_FALSE(ReplayAction::unpack(ReplayAction{}.pack()).action.has_value());
+}
+
+TEST(ReplayTest, ReplayReproducesTheTextOutput)
+{
+    auto directory = recordGame("tanks_game_replay_test");
+
+    ReplayReader reader((directory / "output_board.replay").string());
+    ASSERT_TRUE(reader.is_valid());
+    EXPECT_EQ(reader.header().width, 10u);
+    EXPECT_EQ(reader.header().height, 10u);
+    EXPECT_EQ(reader.header().tanks.size(), 2u);
+    EXPECT_GT(reader.rounds(), 0u);
+
+    std::stringstream text;
+    reader.writeText(text);
+    std::string output = readFile(directory / "output_board.txt");
+    EXPECT_EQ(text.str(), output);
+
+    std::filesystem::remove_all(directory);
+}
+
+TEST(ReplayTest, TankIdsPastAByteRoundTrip)
+{
+    auto directory = std::filesystem::temp_directory_path() / "tanks_game_replay_ids_test";
+    std::filesystem::create_directories(directory);
+    BoardGeneratorOptions options{.width = 40, .height = 40, .wall_density = 0, .mine_density = 0, .players = 2,
+                                  .tanks_per_player = 300, .max_steps = 1, .seed = 4};
+    ASSERT_TRUE(BoardGenerator(options).writeToFile((directory / "board.txt").string()));
+
+    ConcretePlayerFactory player_factory;
+    ConcreteTankAlgorithmFactory algorithm_factory;
+    {
+        GameManager game(player_factory, algorithm_factory, GameOptions{.headless = true, .record_replay = true});
+        ASSERT_TRUE(game.readBoard((directory / "board.txt").string()));
+        game.run();
+    }
+
+    ReplayReader reader((directory / "output_board.replay").string());
+    ASSERT_TRUE(reader.is_valid());
+    ASSERT_EQ(reader.header().tanks.size(), 600u);
+    std::map<uint8_t, std::set<uint32_t>> tank_ids;
+    for (const auto& [player_id, tank_id] : reader.header().tanks)
+    {
+        tank_ids[player_id].insert(tank_id);
+    }
+    EXPECT_EQ(tank_ids[1].size(), 300u);
+    EXPECT_EQ(*tank_ids[2].rbegin(), 299u);
+
+    std::filesystem::remove_all(directory);
+}
+
+TEST(ReplayTest, ReadsVersionOneReplays)
+{
+    // One tank with a u8 id, one round of a valid DoNothing, then the result
+    std::vector<uint8_t> data = {'T', 'N', 'K', 'R', 1};
+    data.insert(data.end(), 8 + 5 * 4, 0);
+    data.insert(data.end(), {1, 0, 0, 0, 1, 7});
+    data.push_back(ReplayAction{ActionRequest::DoNothing, true, true, false}.pack());
+    data.insert(data.end(), {ReplayAction::kEndOfRounds, 3, 0, 0, 0, 'T', 'i', 'e'});
+
+    auto replay_file = std::filesystem::temp_directory_path() / "tanks_game_v1.replay";
+    std::ofstream(replay_file, std::ios::binary).write(reinterpret_cast<const char*>(data.data()), static_cast<std::streamsize>(data.size()));
+
+    ReplayReader reader(replay_file.string());
+    ASSERT_TRUE(reader.is_valid());
+    ASSERT_EQ(reader.header().tanks.size(), 1u);
+    EXPECT_EQ(reader.header().tanks[0], (std::pair<uint8_t, uint32_t>{1, 7}));
+    EXPECT_EQ(reader.rounds(), 1u);
+    EXPECT_EQ(reader.action(0, 0).action, ActionRequest::DoNothing);
+    EXPECT_EQ(reader.result(), "Tie");
+
+    std::filesystem::remove(replay_file);
+}
+
+TEST(ReplayTest, ResimulationMatchesTheRecording)
+{
+    auto directory = recordGame("tanks_game_resimulation_test");
+    std::string output = readFile(directory / "output_board.txt");
+
+    // From the binary replay and from the text output file alike
+    for (const char* recording_name : {"output_board.replay", "output_board.txt"})
+    {
+        ReplayReader recording((directory / recording_name).string());
+        ASSERT_TRUE(recording.is_valid()) << recording_name;
+        EXPECT_EQ(recording.tanks(), 2u);
+
+        std::stringstream text;
+        recording.writeText(text);
+        EXPECT_EQ(text.str(), output) << recording_name;
+
+        GameResult result = resimulate(directory / "board.txt", recording);
+        EXPECT_EQ(result.message, recording.result()) << recording_name;
+        EXPECT_EQ(result.rounds, recording.rounds()) << recording_name;
+        EXPECT_EQ(verifyReplay((directory / "board.txt").string(), recording), "") << recording_name;
+    }
+
+    // Re-simulating leaves the recorded output file alone
+    EXPECT_EQ(readFile(directory / "output_board.txt"), output);
+
+    std::filesystem::remove_all(directory);
+}
+
+TEST(ReplayTest, VerifyRejectsARecordingOfAnotherBoard)
+{
+    auto directory = recordGame("tanks_game_verify_board_test");
+    ReplayReader recording((directory / "output_board.replay").string());
+    ASSERT_TRUE(recording.is_valid());
+
+    // The same tanks, one wall less
+    std::string board = readFile(directory / "board.txt");
+    board.replace(board.find("#..1"), 1, ".");
+    std::ofstream(directory / "other_board.txt") << board;
+    EXPECT_EQ(verifyReplay((directory / "other_board.txt").string(), recording), "the recording is for a different board");
+
+    // One tank more than recorded
+    board.replace(board.find("..2."), 1, "1");
+    std::ofstream(directory / "other_board.txt") << board;
+    EXPECT_EQ(verifyReplay((directory / "other_board.txt").string(), recording), "the recording is for a different board");
+
+    std::filesystem::remove_all(directory);
+}
+
+TEST(ReplayTest, VerifyReportsTheFirstDivergingRound)
+{
+    auto directory = recordGame("tanks_game_verify_round_test");
+    auto replay_file = directory / "output_board.replay";
+    std::string data = readFile(replay_file);
+
+    // The rounds follow the magic, the version, the header's 6 fields and its 2 tanks
+    size_t rounds_offset = 4 + 1 + 8 + 5 * 4 + 4 + 2 * (1 + 4);
+    size_t tampered = rounds_offset + 3 * 2 + 1; // Round 3, tank 1
+    ReplayAction recorded = ReplayAction::unpack(static_cast<uint8_t>(data[tampered]));
+    ASSERT_TRUE(recorded.alive_at_start);
+    data[tampered] = static_cast<char>(recorded.pack() ^ ReplayAction::kValidBit);
+    std::ofstream(replay_file, std::ios::binary) << data;
+
+    ReplayReader recording(replay_file.string());
+    ASSERT_TRUE(recording.is_valid());
+    std::string mismatch = verifyReplay((directory / "board.txt").string(), recording);
+    EXPECT_EQ(mismatch.rfind("diverges at round 3, tank 1: ", 0), 0u) << mismatch;
+
+    std::filesystem::remove_all(directory);
+}
@@ -0,0 +1,112 @@
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include "algorithms/algorithm_utils.h"
+#include "board_satellite_view.h"
+#include "satellite_snapshot.h"
+
+
+namespace
+{
+
+// A view that only has the per-cell interface, like one a third party would hand us
+class PerCellView : public SatelliteView
+{
+public:
+    explicit PerCellView(const SatelliteView& view) : view_(view) {}
+
+    char getObjectAt(size_t x, size_t y) const override { return view_.getObjectAt(x, y); }
+
+private:
+    const SatelliteView& view_;
+};
+
+SatelliteSnapshot makeBoardImage()
+{
+    SatelliteSnapshot image(5, 3);
+    image.at(0, 0) = '#';
+    image.at(4, 0) = '1';
+    image.at(2, 1) = '@';
+    image.at(3, 2) = '*';
+    image.at(1, 2) = '2';
+    return image;
+}
+
+} // namespace
+
+TEST(SatelliteViewTest, BulkCopyMatchesPerCellReads)
+{
+    SatelliteSnapshot image = makeBoardImage();
+    BoardSatelliteView view(image, Position(1, 2));
+    PerCellView per_cell_view(view);
+
+    SatelliteSnapshot bulk;
+    SatelliteSnapshot per_cell;
+    captureSatelliteView(view, image.width(), image.height(), bulk);
+    captureSatelliteView(per_cell_view, image.width(), image.height(), per_cell);
+
+    EXPECT_EQ(bulk.at(1, 2), '%');
+    for (size_t y = 0; y < image.height(); ++y)
+    {
+        for (size_t x = 0; x < image.width(); ++x)
+        {
+            EXPECT_EQ(bulk.at(x, y), view.getObjectAt(x, y)) << "at (" << x << "," << y << ")";
+            EXPECT_EQ(per_cell.at(x, y), view.getObjectAt(x, y)) << "at (" << x << "," << y << ")";
+        }
+    }
+}
+
+TEST(SatelliteViewTest, BulkCopyMarksCellsOutsideTheBoard)
+{
+    SatelliteSnapshot image = makeBoardImage();
+    BoardSatelliteView view(image, Position(4, 0));
+
+    SatelliteSnapshot bulk;
+    captureSatelliteView(view, 6, 4, bulk);
+
+    for (size_t y = 0; y < 4; ++y)
+    {
+        for (size_t x = 0; x < 6; ++x)
+        {
+            EXPECT_EQ(bulk.at(x, y), view.getObjectAt(x, y)) << "at (" << x << "," << y << ")";
+        }
+    }
+}
+
+TEST(SatelliteViewTest, RefreshMatchesAFullReconstruction)
+{
+    SatelliteSnapshot image = makeBoardImage();
+    SatelliteSnapshot before;
+    captureSatelliteView(BoardSatelliteView(image, Position(1, 2)), image.width(), image.height(), before);
+
+    Grid grid;
+    Position tank_pos;
+    reconstructGridFromSnapshot(grid, before, 2, 10, tank_pos);
+
+    // The tank's owner moves it onto the mine in its own model
+    auto* tank = grid[tank_pos].getObjectByType(ObjectType::Tank);
+    grid[tank_pos].removeObject(tank);
+    grid.at(2, 1).addObject(tank);
+
+    // The shell flew on and the wall was destroyed
+    image.at(0, 0) = ' ';
+    image.at(3, 2) = ' ';
+    image.at(3, 1) = '*';
+    SatelliteSnapshot after;
+    captureSatelliteView(BoardSatelliteView(image, Position(1, 2)), image.width(), image.height(), after);
+
+    std::vector<size_t> changed_cells;
+    ASSERT_TRUE(refreshGridFromSnapshot(grid, after, 2, 10, tank_pos, changed_cells));
+    EXPECT_EQ(tank_pos, Position(1, 2));
+    EXPECT_EQ(changed_cells, (std::vector<size_t>{grid.index(0, 0), grid.index(2, 1), grid.index(3, 1),
+                                                  grid.index(1, 2), grid.index(3, 2)}));
+
+    Grid expected;
+    reconstructGridFromSnapshot(expected, after, 2, 10, tank_pos);
+    for (size_t i = 0; i < grid.size(); ++i)
+    {
+        EXPECT_EQ(BoardSatelliteView::cellToChar(grid.cell(i)), BoardSatelliteView::cellToChar(expected.cell(i))) << "at " << i;
+        EXPECT_EQ(grid.cell(i).getObjectsCount(), expected.cell(i).getObjectsCount()) << "at " << i;
+    }
+}
@@ -0,0 +1,69 @@
+#include <gtest/gtest.h>
+
+#include <array>
+
+#include "board.h"
+#include "concrete_player_factory.h"
+#include "concrete_tank_algorithm_factory.h"
+
+
+class ZobristTest : public ::testing::Test
+{
+protected:
+    ConcretePlayerFactory playerFactory_;
+    ConcreteTankAlgorithmFactory algorithmFactory_;
+    Board board;
+
+    ZobristTest() : board(playerFactory_, algorithmFactory_) {}
+
+    void SetUp() override
+    {
+        ASSERT_TRUE(board.loadFromFile("../test/board.txt").is_valid);
+    }
+};
+
+TEST_F(ZobristTest, SameBoardHashesTheSame)
+{
+    Board other(playerFactory_, algorithmFactory_);
+    ASSERT_TRUE(other.loadFromFile("../test/board.txt").is_valid);
+
+    EXPECT_EQ(board.hash(), other.hash());
+    EXPECT_EQ(board.hash(), board.computeHash());
+}
+
+TEST_F(ZobristTest, RotatingBackRestoresTheHash)
+{
+    auto tank = board.getTank(1, 0);
+    uint64_t initial_hash = board.hash();
+
+    auto action = ActionRequest::RotateLeft90;
+    ASSERT_TRUE(board.executeTankAction(tank, action));
+    EXPECT_NE(board.hash(), initial_hash);
+    EXPECT_EQ(board.hash(), board.computeHash());
+
+    action = ActionRequest::RotateRight90;
+    ASSERT_TRUE(board.executeTankAction(tank, action));
+    EXPECT_EQ(board.hash(), initial_hash);
+}
+
+TEST_F(ZobristTest, IncrementalHashFollowsTheGame)
+{
+    // Shooting, moving and rotating tanks, so shells fly, hit walls, and tanks may die
+    const std::array<ActionRequest, 6> script = {ActionRequest::Shoot, ActionRequest::MoveForward, ActionRequest::RotateLeft45,
+                                                 ActionRequest::Shoot, ActionRequest::MoveBackward, ActionRequest::RotateRight90};
+    const std::array<std::shared_ptr<Tank>, 2> tanks = {board.getTank(1, 0), board.getTank(2, 0)};
+
+    for (size_t round = 0; round < 60; ++round)
+    {
+        for (size_t i = 0; i < tanks.size(); ++i)
+        {
+            auto action = script[(round + i) % script.size()];
+            board.executeTankAction(tanks[i], action);
+        }
+        board.doShellsStep(false);
+        ASSERT_EQ(board.hash(), board.computeHash()) << "round " << round;
+
+        board.doShellsStep(true);
+        ASSERT_EQ(board.hash(), board.computeHash()) << "round " << round;
+    }
+}
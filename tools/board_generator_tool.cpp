@@ -0,0 +1,69 @@
+#include <iostream>
+#include <string>
+#include <string_view>
+
+#include "board_generator.h"
+
+
+// Writes a random board in the input file format, for benchmarks and stress tests
+
+static void printUsage()
+{
+    std::cerr << "Usage: tanks_board_generator [--width <cols>] [--height <rows>] [--walls <density>] [--mines <density>]" << std::endl;
+    std::cerr << "                             [--players <1-9>] [--tanks <tanks_per_player>] [--max-steps <steps>]" << std::endl;
+    std::cerr << "                             [--shells <shells>] [--seed <seed>] <output_board_file>" << std::endl;
+}
+
+int main(int argc, char* argv[])
+{
+    BoardGeneratorOptions options;
+    std::string output_file;
+
+    try
+    {
+        for (int i = 1; i < argc; ++i)
+        {
+            std::string_view arg = argv[i];
+            bool has_value = i + 1 < argc;
+
+            if (arg == "--width" && has_value)
+                options.width = std::stoul(argv[++i]);
+            else if (arg == "--height" && has_value)
+                options.height = std::stoul(argv[++i]);
+            else if (arg == "--walls" && has_value)
+                options.wall_density = std::stod(argv[++i]);
+            else if (arg == "--mines" && has_value)
+                options.mine_density = std::stod(argv[++i]);
+            else if (arg == "--players" && has_value)
+                options.players = std::stoul(argv[++i]);
+            else if (arg == "--tanks" && has_value)
+                options.tanks_per_player = std::stoul(argv[++i]);
+            else if (arg == "--max-steps" && has_value)
+                options.max_steps = std::stoul(argv[++i]);
+            else if (arg == "--shells" && has_value)
+                options.num_shells = std::stoul(argv[++i]);
+            else if (arg == "--seed" && has_value)
+                options.seed = std::stoull(argv[++i]);
+            else if (output_file.empty() && !arg.starts_with("--"))
+                output_file = arg;
+            else
+            {
+                printUsage();
+                return 1;
+            }
+        }
+    }
+    catch (const std::exception&)
+    {
+        printUsage();
+        return 1;
+    }
+
+    if (output_file.empty())
+    {
+        printUsage();
+        return 1;
+    }
+
+    return BoardGenerator(options).writeToFile(output_file) ? 0 : 1;
+}
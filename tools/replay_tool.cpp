@@ -0,0 +1,80 @@
+#include <algorithm>
+#include <chrono>
+#include <exception>
+#include <filesystem>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "batch_runner.h"
+#include "global_config.h"
+#include "replay.h"
+#include "replay_verifier.h"
+
+
+// Re-simulates recorded games from their recorded actions and checks they still play out the same way.
+// A game's recording is its binary replay when there is one, otherwise its text output file.
+
+static void printUsage()
+{
+    std::cerr << "Usage: tanks_replay <game_board_file_or_directory>..." << std::endl;
+}
+
+// The files the game wrote for a board, next to it
+static std::filesystem::path recordingFor(const std::string& board_file)
+{
+    std::filesystem::path board_path(board_file);
+    std::filesystem::path output_path = board_path.parent_path() /
+        (std::string(config::get<std::string_view>("output_file_prefix")) + board_path.filename().string());
+
+    std::filesystem::path replay_path = std::filesystem::path(output_path).replace_extension(".replay");
+    return std::filesystem::exists(replay_path) ? replay_path : output_path;
+}
+
+static std::string verify(const std::string& board_file)
+{
+    std::filesystem::path recording_path = recordingFor(board_file);
+    ReplayReader recording(recording_path.string());
+    if (!recording.is_valid())
+    {
+        return "no readable recording at " + recording_path.string();
+    }
+    return verifyReplay(board_file, recording);
+}
+
+int main(int argc, char* argv[])
+{
+    if (argc < 2)
+    {
+        printUsage();
+        return 1;
+    }
+
+    std::vector<std::string> board_files = BatchRunner::collectBoardFiles(std::vector<std::string>(argv + 1, argv + argc));
+    size_t mismatches = 0;
+
+    auto start = std::chrono::steady_clock::now();
+    for (const auto& board_file : board_files)
+    {
+        std::string mismatch;
+        try
+        {
+            mismatch = verify(board_file);
+        }
+        catch (const std::exception& exc)
+        {
+            mismatch = std::string("an exception was thrown: ") + exc.what();
+        }
+
+        if (!mismatch.empty())
+        {
+            ++mismatches;
+            std::cout << "[Replay] " << board_file << ": " << mismatch << std::endl;
+        }
+    }
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+    std::cout << "[Replay] Verified " << board_files.size() << " games, " << mismatches << " mismatched, "
+              << board_files.size() / std::max(elapsed.count(), 1e-9) << " games/sec" << std::endl;
+    return mismatches == 0 ? 0 : 1;
+}